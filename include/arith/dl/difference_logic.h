@@ -0,0 +1,473 @@
+#pragma once
+
+#include "sat_core.h"
+#include "theory.h"
+#include "lin.h"
+#include "dl_traits.h"
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <map>
+#include <memory>
+#include <tuple>
+#include <unordered_set>
+
+namespace semitone
+{
+  template <typename Weight>
+  class dl_value_listener;
+
+  /**
+   * @brief The statistics of the relaxations of a difference logic theory.
+   */
+  struct dl_stats
+  {
+    size_t edges = 0; // the number of relaxed edges..
+    size_t cells = 0; // the number of updated cells of the distance matrix (or, in sparse mode, of updated potentials)..
+  };
+
+  /**
+   * @brief A difference logic theory, managing constraints of the form `to - from <= dist`.
+   *
+   * The theory keeps either the all-pairs distance matrix, incrementally updated, or, in sparse mode, the constraint graph along with a feasible potential function and the distances from and to the origin, incrementally updated as well. In the former case, the variables whose distances get fixed (i.e., `distance(a, b) == -distance(b, a)`) are collapsed into rigid components, each represented by one of its variables, so that only the rows and the columns of the representatives are maintained.
+   *
+   * @tparam Weight the type of the distances (see `dl_traits`).
+   */
+  template <typename Weight>
+  class difference_logic : public theory
+  {
+    friend class dl_value_listener<Weight>;
+
+  public:
+    using weight = Weight;
+    using traits = dl_traits<Weight>;
+
+    /**
+     * @brief Construct a new difference logic theory object.
+     *
+     * @param sat the SAT solver to use.
+     * @param size the initial size of the theory.
+     * @param sparse whether the theory should keep only the constraint graph and a feasible potential function instead of the all-pairs distance matrix.
+     */
+    difference_logic(sat_ptr sat, const size_t &size = 16, const bool sparse = false);
+    difference_logic(sat_ptr sat, const difference_logic &orig);
+    difference_logic(const difference_logic &orig) = delete;
+    virtual ~difference_logic();
+
+    /**
+     * @brief Creates a new difference logice variable.
+     *
+     * @return var the new variable.
+     */
+    var new_var() noexcept;
+
+    lit new_distance(const var &from, const var &to, const Weight &dist) noexcept; // creates and returns a new propositional literal for controlling the constraint `to - from <= dist`..
+    lit new_distance(const var &from, const var &to, const Weight &min, const Weight &max) noexcept { return sat->new_conj({new_distance(to, from, -min), new_distance(from, to, max)}); }
+
+    /**
+     * @brief Creates a new lower then constraint between the given linear expressions and returns the corresponding literal.
+     *
+     * @param left the left hand side of the constraint.
+     * @param right the right hand side of the constraint.
+     * @return lit the literal corresponding to the constraint.
+     */
+    lit new_lt(const lin &left, const lin &right);
+    /**
+     * @brief Creates a new lower then or equal constraint between the given linear expressions and returns the corresponding literal.
+     *
+     * @param left the left hand side of the constraint.
+     * @param right the right hand side of the constraint.
+     * @return lit the literal corresponding to the constraint.
+     */
+    lit new_leq(const lin &left, const lin &right);
+    /**
+     * @brief Creates a new equal constraint between the given linear expressions and returns the corresponding literal.
+     *
+     * @param left the left hand side of the constraint.
+     * @param right the right hand side of the constraint.
+     * @return lit the literal corresponding to the constraint.
+     */
+    lit new_eq(const lin &left, const lin &right);
+    /**
+     * @brief Creates a new greater then or equal constraint between the given linear expressions and returns the corresponding literal.
+     *
+     * @param left the left hand side of the constraint.
+     * @param right the right hand side of the constraint.
+     * @return lit the literal corresponding to the constraint.
+     */
+    lit new_geq(const lin &left, const lin &right);
+    /**
+     * @brief Creates a new greater then constraint between the given linear expressions and returns the corresponding literal.
+     *
+     * @param left the left hand side of the constraint.
+     * @param right the right hand side of the constraint.
+     * @return lit the literal corresponding to the constraint.
+     */
+    lit new_gt(const lin &left, const lin &right);
+
+    /**
+     * @brief Returns the lower bound of the given variable.
+     *
+     * @param v the variable to get the lower bound of.
+     * @return Weight the lower bound of the variable.
+     */
+    inline Weight lb(const var &v) const noexcept { return sparse ? -sp_dist(v, 0) : -dense_dist(v, 0); }
+    /**
+     * @brief Returns the upper bound of the given variable.
+     *
+     * @param v the variable to get the upper bound of.
+     * @return Weight the upper bound of the variable.
+     */
+    inline Weight ub(const var &v) const noexcept { return sparse ? sp_dist(0, v) : dense_dist(0, v); }
+    /**
+     * @brief Returns the bounds of the given variable.
+     *
+     * @param v the variable to get the bounds of.
+     * @return std::pair<Weight, Weight> the bounds of the variable.
+     */
+    inline std::pair<Weight, Weight> bounds(const var &v) const noexcept { return std::make_pair(lb(v), ub(v)); }
+    /**
+     * @brief Returns the distance between the given variables.
+     *
+     * @param from the variable to get the distance from.
+     * @param to the variable to get the distance to.
+     * @return std::pair<Weight, Weight> the distance between the variables.
+     */
+    inline std::pair<Weight, Weight> distance(const var &from, const var &to) const noexcept { return sparse ? std::make_pair(-sp_dist(to, from), sp_dist(from, to)) : std::make_pair(-dense_dist(to, from), dense_dist(from, to)); }
+
+    /**
+     * @brief Returns the bounds of the given linear expression.
+     *
+     * @param l the linear expression to get the bounds of.
+     * @return std::pair<Weight, Weight> the bounds of the linear expression.
+     */
+    std::pair<Weight, Weight> bounds(const lin &l) const;
+    /**
+     * @brief Returns the distance between the given linear expressions.
+     *
+     * @param from the linear expression to get the distance from.
+     * @param to the linear expression to get the distance to.
+     * @return std::pair<Weight, Weight> the distance between the linear expressions.
+     */
+    std::pair<Weight, Weight> distance(const lin &from, const lin &to) const;
+
+    /**
+     * @brief Returns whether the given linear expressions can be equal.
+     *
+     * @param l0 the first linear expression.
+     * @param l1 the second linear expression.
+     * @return bool whether the linear expressions can be equal.
+     */
+    bool matches(const lin &l0, const lin &l1) const;
+
+    /**
+     * @brief Returns the number of variables in the theory.
+     *
+     * @return size_t the number of variables in the theory.
+     */
+    size_t size() const noexcept { return n_vars; }
+
+    /**
+     * @brief Returns whether the theory keeps only the constraint graph and a feasible potential function instead of the all-pairs distance matrix.
+     *
+     * @return bool whether the theory is in sparse mode.
+     */
+    bool is_sparse() const noexcept { return sparse; }
+
+    /**
+     * @brief Returns the maximum number of candidate constraints which are checked for entailment, or violation, each time a constraint is asserted.
+     *
+     * @return size_t the theory propagation budget.
+     */
+    size_t get_propagation_budget() const noexcept { return prop_budget; }
+    /**
+     * @brief Sets the maximum number of candidate constraints which are checked for entailment, or violation, each time a constraint is asserted. In sparse mode, the budget also bounds the number of edges relaxed by each of the two shortest path searches starting from the asserted edge, and the constraints visited by the propagation are accounted even if already assigned. Theory propagation is incomplete once the budget is exhausted, yet the theory remains sound since the skipped constraints are checked when they are assigned.
+     *
+     * @param budget the theory propagation budget.
+     */
+    void set_propagation_budget(const size_t &budget) noexcept { prop_budget = budget; }
+
+    /**
+     * @brief Returns the number of threads which relax the distance matrix.
+     *
+     * @return size_t the number of threads.
+     */
+    size_t get_n_threads() const noexcept;
+    /**
+     * @brief Sets the number of threads which relax the distance matrix. The rows are partitioned among the threads whenever a relaxation pass has at least `threshold` cells to check, while the undo trail and the listeners are updated, in the same order as a sequential relaxation, once the pass is over.
+     *
+     * @param n_threads the number of threads (a single thread disables the parallel relaxation).
+     * @param threshold the minimum number of cells checked by a parallel relaxation pass.
+     */
+    void set_parallelism(const size_t &n_threads, const size_t &threshold = 4096);
+
+    /**
+     * @brief Returns the statistics of the relaxations, whose ratio between updated cells and relaxed edges measures the cost of each propagation. The counters are not updated if the library is compiled with `NO_STATISTICS`.
+     *
+     * @return const dl_stats& the statistics of the relaxations.
+     */
+    const dl_stats &get_stats() const noexcept { return stats; }
+
+    friend json::json to_json(const difference_logic &rhs) noexcept { return rhs.to_json(); }
+
+  public:
+    inline static constexpr Weight inf() noexcept { return traits::inf(); }
+
+  private:
+    class dl_distance;
+
+    bool propagate(const lit &p) noexcept override;
+    bool check() noexcept override;
+    void push() noexcept override;
+    void pop() noexcept override;
+
+    void propagate(const var &from, const var &to, const Weight &dist, const lit &reason) noexcept;
+    void save(const var &from, const var &to) noexcept;
+    struct relaxation;
+    void set_dist(const var &from, const var &to, const Weight &dist, relaxation &rl) noexcept;
+    /**
+     * @brief Runs `f` on `n` items, partitioned into contiguous chunks among the threads if the `cells` to check reach the parallelism threshold, and merges the saved cells of the chunks, in order, into the undo trail.
+     *
+     * @param n the number of items.
+     * @param cells the number of cells to check.
+     * @param f the function relaxing the items in `[begin, end)` into the given chunk.
+     * @return size_t the number of used chunks.
+     */
+    size_t relax(const size_t &n, const size_t &cells, const std::function<void(relaxation &, const size_t &, const size_t &)> &f) noexcept;
+    void set_pred(const var &from, const var &to, const var &pred, const lit &reason) noexcept;
+    /**
+     * @brief Returns the shortest distance from `from` to `to`, computed from the cell of their representatives.
+     *
+     * @param from the source variable.
+     * @param to the target variable.
+     * @return Weight the shortest distance from `from` to `to`.
+     */
+    inline Weight dense_dist(const var &from, const var &to) const noexcept
+    {
+      if (rg_parents[from] == from && rg_parents[to] == to)
+        return _dists[from][to];
+      const auto [r_from, o_from] = rg_find(from);
+      const auto [r_to, o_to] = rg_find(to);
+      if (r_from == r_to)
+        return o_to - o_from;
+      return _dists[r_from][r_to] == inf() ? inf() : _dists[r_from][r_to] + o_to - o_from;
+    }
+    /**
+     * @brief Appends to the `cnfl` vector the negation of the literals enforcing the edges of the current shortest path from `from` to `to`.
+     *
+     * @param from the source of the path.
+     * @param to the target of the path.
+     */
+    void explain(const var &from, const var &to) noexcept;
+    /**
+     * @brief Propagates the unassigned constraint `c_dist` if it is entailed, or violated, by the current distances.
+     *
+     * @param c_dist the constraint to check.
+     */
+    void propagate(const dl_distance &c_dist) noexcept;
+
+    void resize(const size_t &size) noexcept;
+
+    /**
+     * @brief Returns the representative of the rigid component of `v` along with the offset of `v` from it (i.e., `v - rep`).
+     *
+     * @param v the variable to find the representative of.
+     * @return std::pair<var, Weight> the representative and the offset of `v`.
+     */
+    std::pair<var, Weight> rg_find(var v) const noexcept;
+    inline var rg_rep(var v) const noexcept
+    {
+      while (rg_parents[v] != v)
+        v = rg_parents[v];
+      return v;
+    }
+    /**
+     * @brief Merges the rigid components represented by `a` and `b`, whose distances are fixed, the smaller one into the larger one.
+     *
+     * @param a the representative of the first component.
+     * @param b the representative of the second component.
+     */
+    void rg_merge(const var &a, const var &b) noexcept;
+    /**
+     * @brief Appends to the `cnfl` vector the negation of the literals enforcing the path from `v` to its representative (if `up`) or from its representative to `v` (otherwise).
+     *
+     * @param v the member of the rigid component.
+     * @param up the direction of the path.
+     */
+    void rg_explain(var v, const bool up) noexcept;
+
+    struct search;
+
+    /**
+     * @brief Adds the `from -> to` edge, enforced by the `reason` literal, to the constraint graph, updating the potential function and the distances from and to the origin. In case of a negative cycle, the edge is not added and the `cnfl` vector is filled with the (negated) literals of the cycle, except for `reason`.
+     *
+     * @param from the source of the edge.
+     * @param to the target of the edge.
+     * @param dist the weight of the edge.
+     * @param reason the literal enforcing the edge.
+     * @return bool `true` if the edge has been added, `false` if it closes a negative cycle.
+     */
+    bool sp_add_edge(const var &from, const var &to, const Weight &dist, const lit &reason) noexcept;
+    /**
+     * @brief Propagates the unassigned constraints which are entailed, or violated, by the paths passing through the `from -> to` edge.
+     *
+     * @param from the source of the edge.
+     * @param to the target of the edge.
+     * @param dist the weight of the edge.
+     * @param reason the literal enforcing the edge.
+     */
+    void sp_propagate(const var &from, const var &to, const Weight &dist, const lit &reason) noexcept;
+    /**
+     * @brief Computes, through Dijkstra's algorithm on the reduced costs, the shortest distances from (if `forward`) or to (otherwise) the `source` variable. The search stops as soon as the `target` variable is settled, as soon as the distance between `source` and `target` is known to exceed `bound`, or once `limit` edges have been relaxed. In the latter cases, the distances of the reached but unsettled variables are the lengths of actual paths, along their predecessors, yet not necessarily the shortest ones.
+     *
+     * @param source the source of the search.
+     * @param forward whether the search follows the outgoing (`true`) or the incoming (`false`) edges.
+     * @param s the search state to fill.
+     * @param target the variable at which the search can be stopped.
+     * @param limit the maximum number of relaxed edges.
+     * @param bound the distance beyond which the `target` variable is not relevant.
+     */
+    void sp_search(const var &source, const bool forward, search &s, const var &target = std::numeric_limits<var>::max(), const size_t &limit = std::numeric_limits<size_t>::max(), const Weight &bound = inf()) const noexcept;
+    /**
+     * @brief Decreases, after the addition of an edge, the distances from (if `forward`) or to (otherwise) the origin, starting from the `source` variable whose distance becomes `dist`. Only the variables whose distance decreases are visited, in the order of their reduced distances.
+     *
+     * @param source the variable whose distance decreases.
+     * @param forward whether the distances from (`true`) or to (`false`) the origin are updated.
+     * @param dist the new distance of `source`.
+     */
+    void sp_decrease(const var &source, const bool forward, const Weight &dist) noexcept;
+    /**
+     * @brief Returns the shortest distance from `from` to `to` in the constraint graph, or `inf()` if `to` is not reachable from `from`. The distances from and to the origin are maintained, while the other ones are computed by a search which stops as soon as the distance is known to exceed `bound`, in which case a value greater than `bound` is returned.
+     *
+     * @param from the source variable.
+     * @param to the target variable.
+     * @param bound the distance beyond which the exact value is not required.
+     * @return Weight the shortest distance from `from` to `to`, if not greater than `bound`.
+     */
+    Weight sp_dist(const var &from, const var &to, const Weight &bound = inf()) const noexcept;
+
+    void notify(const var &v) noexcept; // notifies the listeners that the bounds of `v` might have changed, deferring the notification for the batched ones..
+    void notify_batched() noexcept;     // delivers the deferred notifications to the batched listeners..
+
+    json::json to_json() const noexcept;
+
+    inline void listen(const var &v, dl_value_listener<Weight> *const l) noexcept { listening[v].insert(l); }
+
+  private:
+    class dl_distance final
+    {
+      friend class difference_logic;
+
+    public:
+      dl_distance(const lit &b, const var &from, const var &to, const Weight &dist) : b(b), from(from), to(to), dist(dist) {}
+      dl_distance(const dl_distance &orig) = delete;
+
+    private:
+      const lit b; // the propositional literal associated to the distance constraint..
+      const var from;
+      const var to;
+      const Weight dist;
+    };
+
+    struct layer
+    {
+      size_t n_cells; // the size of the cells' undo trail when the layer has been created..
+      size_t n_edges; // the number of edges of the constraint graph (sparse mode)..
+      size_t n_merges; // the number of merged rigid components..
+      size_t n_origin; // the size of the undo trail of the distances from and to the origin (sparse mode)..
+    };
+
+    /**
+     * Represents the previous content of a cell of the distance, predecessor and reason matrices.
+     */
+    struct cell_undo
+    {
+      var from, to;
+      Weight dist;    // the previous distance..
+      var pred;       // the previous source of the last edge..
+      lit reason;     // the previous reason..
+      uint32_t stamp; // the previous level at which the cell has been saved..
+    };
+
+    /**
+     * Collects the effects of the relaxation of a chunk of rows.
+     */
+    struct relaxation
+    {
+      std::vector<var> rows;                    // the rows whose cell in the `to` column has been updated..
+      std::vector<var> cols;                    // the columns whose cell in the `from` row has been updated..
+      std::vector<cell_undo> trail;             // the cells saved for backtracking purposes..
+      std::vector<var> changed;                 // the representatives whose bounds have changed..
+      std::vector<std::pair<var, var>> updated; // the updated cells..
+      size_t n_updates = 0;                     // the number of updated cells..
+    };
+
+    class workers;
+
+    /**
+     * Represents an edge of the constraint graph along with the literal which enforces it.
+     */
+    struct edge
+    {
+      var to;      // the target (or the source, for incoming edges) of the edge..
+      Weight dist; // the weight of the edge..
+      lit reason;  // the literal enforcing the edge..
+    };
+
+    /**
+     * Represents the state of a shortest path search on the constraint graph.
+     */
+    struct search
+    {
+      std::vector<Weight> dists; // the distances from (to) the source..
+      std::vector<var> preds;    // the previous (next) variable along the shortest path..
+      std::vector<lit> reasons;  // the literal enforcing the edge to (from) the previous (next) variable..
+      std::vector<char> settled; // whether the distance of the variable is final..
+      std::vector<var> reached;  // the reached variables..
+    };
+
+    const bool sparse;
+    size_t n_vars = 1;
+    std::vector<std::vector<Weight>> _dists;                                // the distance matrix..
+    std::vector<std::vector<var>> _preds;                                   // for each cell, the source of the last edge of the shortest path..
+    std::vector<std::vector<lit>> _reasons;                                 // for each cell, the literal enforcing the last edge of the shortest path..
+    std::vector<std::vector<uint32_t>> _stamps;                             // for each cell, the level at which it has been last saved..
+    std::unordered_map<var, dl_distance *> var_dists;                       // the constraints controlled by a propositional variable (for propagation purposes)..
+    std::vector<layer> layers;                                              // the watermarks of the undo trails, for each level..
+    std::vector<cell_undo> cells_trail;                                     // the flat undo trail of the updated cells..
+    std::map<std::pair<var, var>, std::vector<lit>> expls;                  // the memoized explanations of the shortest paths (valid until the distances change)..
+    std::vector<std::vector<dl_distance *>> from_constrs;                   // for each variable, the constraints starting from it (for propagation purposes)..
+    std::vector<std::vector<dl_distance *>> to_constrs;                     // for each variable, the constraints ending in it (for propagation purposes)..
+    std::vector<uint32_t> col_stamps;                                       // for each variable, the last propagation in which a cell of its column might have been updated..
+    uint32_t c_stamp = 0;                                                   // the current propagation stamp..
+    size_t prop_budget = std::numeric_limits<size_t>::max();                // the maximum number of candidate constraints checked by each propagation..
+    std::unordered_map<var, std::set<dl_value_listener<Weight> *>> listening;
+    std::vector<var> batch;                                                 // the listened variables whose bounds might have changed since the last batched notification..
+    std::unordered_set<var> in_batch;                                       // the same variables, for deduplication purposes..
+
+    std::vector<var> rg_parents;                  // for each variable, the variable it has been merged into (itself, for representatives)..
+    std::vector<Weight> rg_offs;                  // for each variable, its offset from its parent..
+    std::vector<std::vector<lit>> rg_ups;         // for each variable, the literals enforcing the path to its parent..
+    std::vector<std::vector<lit>> rg_downs;       // for each variable, the literals enforcing the path from its parent..
+    std::vector<std::vector<var>> rg_members;     // for each representative, the variables of its rigid component (the tail belongs to the merged components)..
+    std::vector<std::pair<var, var>> rg_trail;    // the merged representatives along with the representatives they have been merged into, in chronological order..
+
+    std::unique_ptr<workers> pool;                // the threads relaxing the distance matrix (if any)..
+    size_t par_threshold = 4096;                  // the minimum number of cells checked by a parallel relaxation pass..
+    std::vector<relaxation> chunks;               // the effects of the relaxation of each chunk of rows..
+
+    std::vector<Weight> pots;                                     // a feasible potential function for the constraint graph (sparse mode)..
+    std::vector<std::vector<edge>> out_edges;                     // for each variable, the outgoing edges (sparse mode)..
+    std::vector<std::vector<edge>> in_edges;                      // for each variable, the incoming edges (sparse mode)..
+    std::vector<std::pair<var, var>> edges_trail;                 // the added edges, in chronological order (sparse mode)..
+    std::vector<Weight> origin_fwd, origin_bwd;                   // the distances from and to the origin (sparse mode)..
+    std::vector<std::tuple<var, bool, Weight>> origin_trail;      // the previous distances from (`true`) or to (`false`) the origin, in chronological order (sparse mode)..
+    mutable search c_fwd, c_bwd, c_query;                         // the search states (sparse mode)..
+
+    dl_stats stats; // the statistics of the relaxations..
+  };
+
+  extern template class SEMITONE_EXPORT difference_logic<utils::I>;
+  extern template class SEMITONE_EXPORT difference_logic<int32_t>;
+  extern template class SEMITONE_EXPORT difference_logic<utils::inf_rational>;
+} // namespace semitone
@@ -0,0 +1,112 @@
+#pragma once
+
+#include "inf_rational.h"
+#include "integer.h"
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+
+namespace semitone
+{
+  /**
+   * @brief The properties of the weights of a difference logic theory.
+   *
+   * Each specialization provides the additive identity (`zero`), the value representing an unbounded distance (`inf`), the smallest positive distance (`epsilon`), used for negating constraints, and the conversions from the rational constants of the linear expressions into weights. The `leq_bound` and `lt_bound` conversions return the tightest weight `w` such that `x <= w` is equivalent to, respectively, `x <= c` and `x < c` (integer weights are rounded).
+   *
+   * @tparam Weight the type of the weights.
+   */
+  template <typename Weight>
+  struct dl_traits;
+
+  /**
+   * @brief The properties of integer weights.
+   *
+   * @tparam Int the integral type of the weights.
+   */
+  template <typename Int>
+  struct dl_int_traits
+  {
+    static_assert(std::numeric_limits<Int>::is_integer && std::numeric_limits<Int>::is_signed, "integer weights must be signed integers");
+
+    static constexpr Int zero() noexcept { return 0; }
+    static constexpr Int inf() noexcept { return std::numeric_limits<Int>::max() / 2 - 1; } // the sum of two finite distances does not overflow..
+    static constexpr Int epsilon() noexcept { return 1; }
+
+    static Int leq_bound(const utils::rational &c) noexcept { return narrow(floor(c)); }
+    static Int lt_bound(const utils::rational &c) noexcept { return narrow(-floor(-c) - 1); }
+
+    /**
+     * @brief Converts the given constant into a weight, throwing an `std::invalid_argument` exception if the constant is not an integer.
+     */
+    static Int to_weight(const utils::rational &c)
+    {
+      if (!is_integer(c))
+        throw std::invalid_argument("not a valid integer difference logic constraint..");
+      return narrow(c.numerator());
+    }
+    /**
+     * @brief Multiplies the given weight by the given coefficient, throwing an `std::invalid_argument` exception if the coefficient is not an integer.
+     */
+    static Int scale(const Int &w, const utils::rational &c)
+    {
+      if (!is_integer(c))
+        throw std::invalid_argument("not a valid integer difference logic expression..");
+      if (w >= inf() || w <= -inf()) // the distance is unbounded..
+        return (w > 0) == (c.numerator() > 0) ? inf() : -inf();
+      return narrow(static_cast<utils::I>(w) * c.numerator());
+    }
+    static utils::inf_rational to_inf_rational(const Int &w) noexcept
+    {
+      if (w >= inf())
+        return utils::inf_rational(utils::rational::POSITIVE_INFINITY);
+      if (w <= -inf())
+        return utils::inf_rational(utils::rational::NEGATIVE_INFINITY);
+      return utils::inf_rational(utils::rational(static_cast<utils::I>(w)));
+    }
+
+  private:
+    static utils::I floor(const utils::rational &c) noexcept
+    {
+      assert(c.denominator() > 0);
+      const utils::I q = c.numerator() / c.denominator();
+      return c.numerator() < 0 && q * c.denominator() != c.numerator() ? q - 1 : q;
+    }
+    static Int narrow(const utils::I &w) noexcept
+    {
+      assert(w > -static_cast<utils::I>(inf()) && w < static_cast<utils::I>(inf())); // the weight must fit the (possibly narrower) integer type..
+      return static_cast<Int>(w);
+    }
+  };
+
+  template <>
+  struct dl_traits<utils::I> : dl_int_traits<utils::I>
+  {
+  };
+
+  /**
+   * @brief The properties of 32-bit integer weights, which halve the size of the distance matrix and suit bounded horizons.
+   */
+  template <>
+  struct dl_traits<int32_t> : dl_int_traits<int32_t>
+  {
+  };
+
+  /**
+   * @brief The properties of real weights, extended with an infinitesimal part for representing strict constraints.
+   */
+  template <>
+  struct dl_traits<utils::inf_rational>
+  {
+    static utils::inf_rational zero() noexcept { return utils::inf_rational(utils::rational::ZERO); }
+    static utils::inf_rational inf() noexcept { return utils::inf_rational(utils::rational::POSITIVE_INFINITY); }
+    static utils::inf_rational epsilon() noexcept { return utils::inf_rational(utils::rational::ZERO, utils::rational::ONE); }
+
+    static utils::inf_rational leq_bound(const utils::rational &c) noexcept { return utils::inf_rational(c); }
+    static utils::inf_rational lt_bound(const utils::rational &c) noexcept { return utils::inf_rational(c, -1); }
+
+    static utils::inf_rational to_weight(const utils::rational &c) noexcept { return utils::inf_rational(c); }
+    static utils::inf_rational scale(const utils::inf_rational &w, const utils::rational &c) noexcept { return w * c; }
+    static utils::inf_rational to_inf_rational(const utils::inf_rational &w) noexcept { return w; }
+  };
+} // namespace semitone
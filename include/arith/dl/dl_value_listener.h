@@ -0,0 +1,29 @@
+#pragma once
+
+#include "difference_logic.h"
+#include <vector>
+
+namespace semitone
+{
+  template <typename Weight>
+  class dl_value_listener
+  {
+    friend class difference_logic<Weight>;
+
+  public:
+    dl_value_listener(difference_logic<Weight> &s, const bool batched = false) : th(s), batched(batched) {}
+    dl_value_listener(const dl_value_listener &that) = delete;
+    virtual ~dl_value_listener() = default;
+
+  protected:
+    inline void listen_dl(var v) noexcept { th.listen(v, this); }
+
+  private:
+    virtual void dl_value_change(const var &) {}
+    virtual void dl_values_change(const std::vector<var> &) {} // called, for batched listeners, once the theory is found consistent, with the variables whose bounds might have changed since the last notification..
+
+  private:
+    difference_logic<Weight> &th;
+    const bool batched; // whether the notifications are deferred until the theory is found consistent..
+  };
+} // namespace semitone
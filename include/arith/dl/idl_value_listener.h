@@ -1,25 +1,24 @@
 #pragma once
 
 #include "idl_theory.h"
+#include "dl_value_listener.h"
 
 namespace semitone
 {
-  class idl_value_listener
+  class idl_value_listener : public dl_value_listener<utils::I>
   {
-    friend class idl_theory;
-
   public:
-    idl_value_listener(idl_theory &s) : th(s) {}
+    idl_value_listener(idl_theory &s, const bool batched = false) : dl_value_listener(s, batched) {}
     idl_value_listener(const idl_value_listener &that) = delete;
     virtual ~idl_value_listener() = default;
 
   protected:
-    inline void listen_idl(var v) { th.listen(v, this); }
+    inline void listen_idl(var v) { listen_dl(v); }
 
   private:
+    void dl_value_change(const var &v) override { idl_value_change(v); }
+    void dl_values_change(const std::vector<var> &vs) override { idl_values_change(vs); }
     virtual void idl_value_change(const var &) {}
-
-  private:
-    idl_theory &th;
+    virtual void idl_values_change(const std::vector<var> &) {}
   };
-} // namespace semitone
\ No newline at end of file
+} // namespace semitone
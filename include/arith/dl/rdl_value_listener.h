@@ -1,25 +1,24 @@
 #pragma once
 
 #include "rdl_theory.h"
+#include "dl_value_listener.h"
 
 namespace semitone
 {
-  class rdl_value_listener
+  class rdl_value_listener : public dl_value_listener<utils::inf_rational>
   {
-    friend class rdl_theory;
-
   public:
-    rdl_value_listener(rdl_theory &s) : th(s) {}
+    rdl_value_listener(rdl_theory &s, const bool batched = false) : dl_value_listener(s, batched) {}
     rdl_value_listener(const rdl_value_listener &that) = delete;
     virtual ~rdl_value_listener() = default;
 
   protected:
-    inline void listen_rdl(var v) noexcept { th.listen(v, this); }
+    inline void listen_rdl(var v) noexcept { listen_dl(v); }
 
   private:
+    void dl_value_change(const var &v) override { rdl_value_change(v); }
+    void dl_values_change(const std::vector<var> &vs) override { rdl_values_change(vs); }
     virtual void rdl_value_change(const var &) {}
-
-  private:
-    rdl_theory &th;
+    virtual void rdl_values_change(const std::vector<var> &) {}
   };
-} // namespace semitone
\ No newline at end of file
+} // namespace semitone
@@ -15,6 +15,15 @@ namespace semitone
   class assertion;
   class row;
 
+  /**
+   * @brief The statistics of the simplex of a linear real arithmetic theory.
+   */
+  struct lra_stats
+  {
+    size_t pivots = 0;      // the number of pivots..
+    size_t row_updates = 0; // the number of tableau rows rewritten by the pivots..
+  };
+
   class lra_theory : public theory
   {
     friend class lra_value_listener;
@@ -161,6 +170,13 @@ namespace semitone
      */
     SEMITONE_EXPORT bool matches(const lin &l0, const lin &l1) const noexcept;
 
+    /**
+     * @brief Returns the statistics of the simplex. The counters are not updated if the library is compiled with `NO_STATISTICS`.
+     *
+     * @return const lra_stats& the statistics of the simplex.
+     */
+    inline const lra_stats &get_stats() const noexcept { return stats; }
+
     bool set_lb(const var &x_i, const utils::inf_rational &val, const lit &p) noexcept { return assert_lower(x_i, val, p); }
     bool set_ub(const var &x_i, const utils::inf_rational &val, const lit &p) noexcept { return assert_upper(x_i, val, p); }
     bool set(const var &x_i, const utils::inf_rational &val, const lit &p) noexcept { return set_lb(x_i, val, p) && set_ub(x_i, val, p); }
@@ -193,6 +209,8 @@ namespace semitone
     void pivot_and_update(const var &x_i, const var &x_j, const utils::inf_rational &v) noexcept;
     void pivot(const var x_i, const var x_j) noexcept;
     void new_row(const var &x, const lin &l) noexcept;
+    void notify(const var &x) noexcept; // notifies the listeners that the value of `x` has changed, deferring the notification for the batched ones..
+    void notify_batched() noexcept;     // delivers the deferred notifications to the batched listeners..
 
     inline void listen(const var &v, lra_value_listener *const l) noexcept
     {
@@ -225,5 +243,8 @@ namespace semitone
     std::vector<std::unordered_set<row *>> t_watches;      // for each variable `v`, a list of tableau rows watching `v`..
     std::vector<std::unordered_map<size_t, bound>> layers; // we store the updated bounds..
     std::unordered_map<var, std::set<lra_value_listener *>> listening;
+    std::vector<var> batch;           // the listened variables whose value has changed since the last batched notification..
+    std::unordered_set<var> in_batch; // the same variables, for deduplication purposes..
+    lra_stats stats;                  // the statistics of the simplex..
   };
 } // namespace semitone
\ No newline at end of file
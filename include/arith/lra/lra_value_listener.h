@@ -1,6 +1,7 @@
 #pragma once
 
 #include "lra_theory.h"
+#include <vector>
 
 namespace semitone
 {
@@ -9,7 +10,7 @@ namespace semitone
     friend class lra_theory;
 
   public:
-    lra_value_listener(lra_theory &s) : th(s) {}
+    lra_value_listener(lra_theory &s, const bool batched = false) : th(s), batched(batched) {}
     lra_value_listener(const lra_value_listener &that) = delete;
     virtual ~lra_value_listener() = default;
 
@@ -18,8 +19,10 @@ namespace semitone
 
   private:
     virtual void lra_value_change(const var &) {}
+    virtual void lra_values_change(const std::vector<var> &) {} // called, for batched listeners, once the theory is found consistent, with the variables whose value has changed since the last notification..
 
   private:
     lra_theory &th;
+    const bool batched; // whether the notifications are deferred until the theory is found consistent..
   };
 } // namespace semitone
\ No newline at end of file
@@ -5,7 +5,6 @@
 namespace semitone
 {
   class sat_core;
-  class theory;
 
   /**
    * This class is used for representing propositional clauses.
@@ -13,7 +12,6 @@ namespace semitone
   class clause final : public constr
   {
     friend class sat_core;
-    friend class theory;
 
   private:
     /**
@@ -34,6 +32,8 @@ namespace semitone
     bool propagate(const lit &p) noexcept override;
     bool simplify() noexcept override;
     void get_reason(const lit &p, std::vector<lit> &out_reason) const noexcept override;
+    void get_watched(std::vector<lit> &out_watched) const noexcept override;
+    const std::vector<lit> *get_clause() const noexcept override { return &lits; }
 
     virtual json::json to_json() const noexcept override;
 
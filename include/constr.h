@@ -28,6 +28,8 @@ namespace semitone
     virtual bool propagate(const lit &p) noexcept = 0;
     virtual bool simplify() noexcept = 0;
     virtual void get_reason(const lit &p, std::vector<lit> &out_reason) const noexcept = 0;
+    virtual void get_watched(std::vector<lit> &out_watched) const noexcept = 0; // appends the literals whose watch lists contain this constraint..
+    virtual const std::vector<lit> *get_clause() const noexcept { return nullptr; } // returns the literals of the constraint, if it is a clause..
 
     virtual json::json to_json() const noexcept { return json::json(); }
     friend json::json to_json(const constr &rhs) noexcept { return rhs.to_json(); }
@@ -40,8 +42,10 @@ namespace semitone
     utils::lbool value(const lit &p) const noexcept;
 
     void remove_constr_from_reason(const var &x) noexcept;
+    inline bool is_detached() const noexcept { return detached; }
 
   private:
     sat_core &sat;
+    bool detached = false; // whether the sat core has already removed this constraint from the watch lists and from the reasons..
   };
 } // namespace semitone
\ No newline at end of file
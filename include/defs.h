@@ -2,6 +2,12 @@
 
 #include <cstddef>
 
+#ifdef NO_STATISTICS
+#define SEMITONE_STATS(stmt)
+#else
+#define SEMITONE_STATS(stmt) stmt // updates the statistics, unless they are removed at compile time..
+#endif
+
 namespace semitone
 {
   using var = size_t;
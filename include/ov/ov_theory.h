@@ -3,6 +3,7 @@
 #include "sat_core.h"
 #include "theory.h"
 #include "enum.h"
+#include <iterator>
 #include <string>
 #include <unordered_set>
 #include <unordered_map>
@@ -17,6 +18,8 @@ namespace semitone
     friend class ov_value_listener;
 
   public:
+    class domain_view;
+
     SEMITONE_EXPORT ov_theory(sat_ptr sat);
     ov_theory(const ov_theory &orig) = delete;
 
@@ -25,20 +28,131 @@ namespace semitone
 
     SEMITONE_EXPORT lit allows(const var &v, utils::enum_val &val) const noexcept; // returns the literal controlling the presence of the `val` value into the domain of variable `v`..
     SEMITONE_EXPORT lit new_eq(const var &left, const var &right) noexcept;        // creates an equality constraints between `left` and `right` variables returning the literal that controls it..
+    SEMITONE_EXPORT bool new_all_different(const std::vector<var> &vars) noexcept; // enforces the `vars` object variables, each taking exactly one value, to take pairwise different values, returning false if the constraint is inconsistent at the root level..
 
     SEMITONE_EXPORT std::unordered_set<utils::enum_val *> value(var v) const noexcept; // returns the current domain of the object variable `v`..
 
+    inline domain_view domain(const var &v) const noexcept;                                  // returns a view, which does not allocate, over the current domain of the object variable `v`..
+    SEMITONE_EXPORT size_t domain_size(const var &v) const noexcept;                         // returns the number of values in the current domain of the object variable `v`..
+    SEMITONE_EXPORT bool contains(const var &v, const utils::enum_val &val) const noexcept; // checks whether the current domain of the object variable `v` contains the `val` value..
+
   private:
-    bool propagate(const lit &) noexcept override { return true; }
-    bool check() noexcept override { return true; }
+    bool propagate(const lit &p) noexcept override;
+    bool check() noexcept override;
     void push() noexcept override {}
-    void pop() noexcept override {}
+    void pop() noexcept override;
+
+    bool propagate_eq(const size_t &eq_id) noexcept;                       // propagates the equality constraint `eq_id` on all the values of the domains of its variables..
+    bool propagate_eq(const lit &eq, const lit &left, const lit &right) noexcept; // propagates the `eq -> (left <-> right)` and `left & right -> eq` clauses, where `left` and `right` control the presence of a same value into the domains..
+    template <typename F>
+    bool for_each_value(const var &left, const var &right, F f) const; // calls `f` with the literals controlling the presence of each value of the union of the domains (`FALSE_lit` for the missing ones), stopping as soon as `f` returns false..
+
+    struct ov_all_different;
+    bool propagate_all_different(const size_t &ad_id) noexcept;   // repairs the maximum matching of the all-different constraint `ad_id` and prunes the values which belong to no maximum matching (Regin)..
+    bool augment(ov_all_different &ad, const size_t &i) noexcept; // looks for an augmenting path, for the matching of `ad`, starting from its `i`-th variable..
 
     SEMITONE_EXPORT void listen(const var &v, ov_value_listener *const l) noexcept;
+    void notify_listeners() noexcept; // delivers the pending domain changes to the listeners..
+
+    var new_domain(std::vector<std::pair<size_t, lit>> dom) noexcept; // stores the given (value id, literal) pairs as the domain of a new object variable..
+    size_t value_id(utils::enum_val &val) noexcept;                  // returns the id of the `val` value, indexing it if necessary..
+    size_t find(const var &v, const utils::enum_val &val) const noexcept; // returns the position of the `val` value within the flat domain arrays, or the end of the domain of `v` if `val` is not in it..
+    size_t find(const var &v, const size_t &val_id) const noexcept;       // returns the position of the value having the `val_id` id within the flat domain arrays, or the end of the domain of `v` if the value is not in it..
+    var owner(const size_t &pos) const noexcept;                          // returns the object variable whose domain contains the given position of the flat domain arrays..
+
+  private:
+    std::unordered_map<const utils::enum_val *, size_t> val_ids; // the dense index of the values (value to value id)..
+    std::vector<utils::enum_val *> vals;                          // the indexed values (value id to value)..
+    std::vector<size_t> doms;                                     // the position, within the flat domain arrays, of the first value of each object variable (plus the end of the last domain)..
+    std::vector<size_t> dom_vals;                                 // the value ids of the domains, sorted within each domain..
+    std::vector<lit> dom_lits;                                    // the literals controlling the presence of the values into the domains..
+    std::unordered_map<var, std::vector<size_t>> var_pos;         // the positions, within the flat domain arrays, of the literals of each propositional variable..
+
+    struct ov_eq
+    {
+      lit eq;           // the literal controlling the equality..
+      var left, right;  // the constrained object variables..
+    };
+    std::vector<ov_eq> eqs;                                       // the equality constraints..
+    std::unordered_map<var, size_t> eq_ids;                       // the equality constraints controlled by a propositional variable..
+    std::vector<std::vector<size_t>> var_eqs;                     // for each object variable, the equality constraints it is involved in..
+
+    struct ov_all_different
+    {
+      std::vector<var> vars;                                     // the constrained object variables..
+      std::vector<std::vector<std::pair<size_t, size_t>>> edges; // for each variable, the positions of its values within the flat domain arrays along with their index within the constraint..
+      size_t n_vals;                                             // the number of distinct values of the variables..
+      std::vector<size_t> var_match;                             // for each variable, the index of its matched edge (if any)..
+      std::vector<size_t> val_match;                             // for each value, the index of its matched variable (if any)..
+      std::vector<uint32_t> var_seen, val_seen;                  // the last search which has visited each variable and value..
+      uint32_t stamp = 0;                                        // the current search..
+      bool dirty = false;                                        // whether some value has been assigned since the last propagation..
+    };
+    std::vector<ov_all_different> all_diffs;                      // the all-different constraints..
+    std::vector<std::vector<size_t>> var_all_diffs;               // for each object variable, the all-different constraints it is involved in..
+    std::vector<size_t> dirty_all_diffs;                          // the all-different constraints to propagate..
+    std::unordered_map<std::string, lit> exprs;                   // the already existing expressions (string to literal)..
+    std::vector<ov_value_listener *> listeners;                   // the listeners, notified of the domain changes at the end of each propagation round and of each backtracking step..
+    std::unordered_map<var, std::set<var>> is_contained_in;       // the propositional variable contained in the object variables (bool variable to object variables)..
+  };
+
+  /**
+   * A view over the current domain of an object variable, skipping the values whose literal is false.
+   */
+  class ov_theory::domain_view final
+  {
+  public:
+    class iterator final
+    {
+    public:
+      using iterator_category = std::forward_iterator_tag;
+      using value_type = utils::enum_val *;
+      using difference_type = std::ptrdiff_t;
+      using pointer = utils::enum_val *const *;
+      using reference = utils::enum_val *const &;
+
+      iterator(const ov_theory &th, const size_t &pos, const size_t &end) noexcept : th(&th), pos(pos), end(end) { skip(); }
+
+      reference operator*() const noexcept { return th->vals[th->dom_vals[pos]]; }
+      const lit &allows() const noexcept { return th->dom_lits[pos]; } // returns the literal controlling the presence of the current value..
+
+      iterator &operator++() noexcept
+      {
+        ++pos;
+        skip();
+        return *this;
+      }
+      iterator operator++(int) noexcept
+      {
+        iterator it = *this;
+        ++*this;
+        return it;
+      }
+
+      bool operator==(const iterator &other) const noexcept { return pos == other.pos; }
+      bool operator!=(const iterator &other) const noexcept { return pos != other.pos; }
+
+    private:
+      void skip() noexcept
+      {
+        while (pos < end && th->sat->value(th->dom_lits[pos]) == utils::False)
+          ++pos;
+      }
+
+    private:
+      const ov_theory *th;
+      size_t pos, end;
+    };
+
+    domain_view(const ov_theory &th, const var &v) noexcept : th(th), v(v) {}
+
+    iterator begin() const noexcept { return iterator(th, th.doms[v], th.doms[v + 1]); }
+    iterator end() const noexcept { return iterator(th, th.doms[v + 1], th.doms[v + 1]); }
 
   private:
-    std::vector<std::unordered_map<utils::enum_val *, lit>> assigns; // the current assignments (val to literal)..
-    std::unordered_map<std::string, lit> exprs;                      // the already existing expressions (string to literal)..
-    std::unordered_map<var, std::set<var>> is_contained_in;          // the propositional variable contained in the object variables (bool variable to object variables)..
+    const ov_theory &th;
+    const var v;
   };
+
+  inline ov_theory::domain_view ov_theory::domain(const var &v) const noexcept { return domain_view(*this, v); }
 } // namespace semitone
\ No newline at end of file
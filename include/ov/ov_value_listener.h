@@ -2,6 +2,9 @@
 
 #include "ov_theory.h"
 #include "sat_value_listener.h"
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
 
 namespace semitone
 {
@@ -10,23 +13,45 @@ namespace semitone
     friend class ov_theory;
 
   public:
-    ov_value_listener(ov_theory &s) : sat_value_listener(s.sat), th(s) {}
+    ov_value_listener(ov_theory &s) : sat_value_listener(s.sat), th(s) { th.listeners.push_back(this); }
     ov_value_listener(const ov_value_listener &that) = delete;
-    virtual ~ov_value_listener() = default;
+    virtual ~ov_value_listener() { th.listeners.erase(std::find(th.listeners.cbegin(), th.listeners.cend(), this)); }
 
   protected:
     inline void listen_set(var v) noexcept { th.listen(v, this); }
 
+    struct ov_delta
+    {
+      std::vector<utils::enum_val *> removed;  // the values removed from the domain..
+      std::vector<utils::enum_val *> restored; // the values restored into the domain by backtracking..
+      utils::enum_val *fixed = nullptr;        // the only value left, if the domain has just become a singleton..
+    };
+
   private:
     virtual void ov_value_change(const var &) {}
+    virtual void ov_domain_change(const var &, const ov_delta &) {} // called once per propagation round (or backtracking step) with the net changes of the domain of a listened variable..
 
     void sat_value_change(const var &v) override
     {
       for (auto l : th.is_contained_in[v])
+      {
         ov_value_change(l);
+        if (const auto at_l = snapshots.find(l); at_l != snapshots.end() && !at_l->second.dirty)
+        {
+          at_l->second.dirty = true;
+          dirty.push_back(l);
+        }
+      }
     }
 
   private:
     ov_theory &th;
+    struct ov_snapshot
+    {
+      std::vector<bool> alive; // the presence of the values as last notified..
+      bool dirty = false;      // whether the domain might have changed since the last notification..
+    };
+    std::unordered_map<var, ov_snapshot> snapshots; // the snapshots of the domains of the listened variables..
+    std::vector<var> dirty;                         // the listened variables whose domain might have changed since the last notification..
   };
 } // namespace semitone
\ No newline at end of file
@@ -9,6 +9,12 @@
 #include <string>
 #include <unordered_map>
 #include <set>
+#include <tuple>
+#include <functional>
+#include <limits>
+#include <atomic>
+#include <chrono>
+#include <cassert>
 
 namespace semitone
 {
@@ -17,6 +23,31 @@ namespace semitone
   class theory;
   class sat_value_listener;
 
+  /**
+   * @brief The resources available to the sat core for propagating, checking the theories and searching, each limit being ignored if equal to its maximum value.
+   */
+  struct sat_budget
+  {
+    size_t conflicts = std::numeric_limits<size_t>::max();                                         // the maximum number of conflicts..
+    size_t propagations = std::numeric_limits<size_t>::max();                                      // the maximum number of propagated literals..
+    size_t pivots = std::numeric_limits<size_t>::max();                                            // the maximum number of pivots of the linear real arithmetic theories..
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max(); // the wall-clock deadline..
+    const std::atomic<bool> *interrupt = nullptr;                                                  // an optional flag which, once set (possibly by another thread), interrupts the sat core..
+  };
+
+  /**
+   * @brief The statistics of the sat core, cumulated since its creation.
+   */
+  struct sat_stats
+  {
+    size_t decisions = 0;    // the number of assumed literals..
+    size_t propagations = 0; // the number of propagated literals..
+    size_t conflicts = 0;    // the number of conflicts (either propositional or theory ones) which have been analyzed..
+    size_t learnts = 0;      // the number of learnt clauses..
+    size_t learnt_lits = 0;  // the overall number of literals of the learnt clauses..
+    size_t watch_visits = 0; // the number of constraints visited while propagating the watched literals..
+  };
+
   class sat_core final : public utils::countable
   {
     friend class sat_stack;
@@ -109,6 +140,64 @@ namespace semitone
      * @return bool `true` if the current set of assumptions is satisfiable, `false` otherwise.
      */
     SEMITONE_EXPORT bool simplify_db() noexcept;
+    /**
+     * @brief Simplify, at root level, the clause database by removing the subsumed clauses and by strengthening the clauses through self-subsuming resolution. The formula remains equivalent, hence the variables bound to theories or listened remain untouched.
+     *
+     * @param budget the maximum number of literal comparisons performed by the subsumption checks.
+     * @return bool `false` if the simplification detects an inconsistency, `true` otherwise.
+     */
+    SEMITONE_EXPORT bool subsume(const size_t &budget = 10000000) noexcept;
+    /**
+     * @brief Eliminate, at root level, the non-frozen variables whose elimination, through the replacement of the clauses containing them with their non-tautological resolvents, does not increase the number of clauses. The eliminated variables must not be used anymore, their values being computed by `get_model()` through the elimination stack. The variables bound to theories, the listened variables and the variables of the reified expressions are frozen automatically.
+     *
+     * @param budget the maximum number of literals visited while computing the resolvents.
+     * @return bool `false` if the elimination detects an inconsistency, `true` otherwise.
+     */
+    SEMITONE_EXPORT bool eliminate(const size_t &budget = 10000000) noexcept;
+    /**
+     * @brief Substitute, at root level, the equivalent literals with a representative of their class. The equivalence classes are the strongly connected components of the implication graph of the binary clauses, and the representative of each class is one of its frozen variables, if any. The non-frozen variables of each class are removed from all the clauses and from the reified expressions, yet their value keeps following the one of their representative. The procedures taking literals (e.g., `assume()`, `check()`, `backbone()`, `probe()` or `lookahead()`) accept the substituted literals as well, handling them through their representatives.
+     *
+     * @return bool `false` if a literal is found equivalent to its negation, `true` otherwise.
+     */
+    SEMITONE_EXPORT bool substitute() noexcept;
+    /**
+     * @brief Prevent the elimination of variable `x`, which is going to be used after the simplification.
+     *
+     * @param x the variable to freeze.
+     */
+    inline void freeze(const var &x) noexcept { frozen[x] = true; }
+    inline bool is_frozen(const var &x) const noexcept { return frozen[x]; }         // checks whether variable `x` is protected from elimination..
+    inline bool is_eliminated(const var &x) const noexcept { return eliminated[x]; } // checks whether variable `x` has been eliminated..
+    /**
+     * @brief Return the current assignment, extended to the eliminated variables through the elimination stack. The extended assignment satisfies the original clauses whenever the current assignment is complete and consistent.
+     *
+     * @return std::vector<utils::lbool> the value of each variable.
+     */
+    SEMITONE_EXPORT std::vector<utils::lbool> get_model() const noexcept;
+    /**
+     * @brief Enable chronological backtracking for the conflicts whose backjump would retract more than `threshold` decision levels. In such cases, only the last decision level is retracted, and the asserting literal of the learnt clause is assigned at the current decision level, so that the assignments of the intermediate levels, as well as the state of the theories, are preserved. The asserting literal is assigned again, along with its consequences, whenever a later backtracking retracts its decision level but not the one at which the learnt clause implies it. A `threshold` equal to `std::numeric_limits<size_t>::max()` (the default) disables chronological backtracking.
+     *
+     * @param threshold the maximum number of decision levels retracted by a backjump.
+     */
+    inline void set_chrono_threshold(const size_t &threshold) noexcept { chrono_threshold = threshold; }
+    /**
+     * @brief Set the resources available to the sat core, resetting the consumed ones. When a resource is exhausted, or the interrupt flag is set, the running propagation stops and returns `false`, while `is_interrupted()` returns `true` for distinguishing the interruption from an inconsistency. The sat core is left in a consistent state, in which the decision levels are preserved and the literals still to be propagated are kept: either `pop()` retracts the interrupted decision level, or `propagate()`, once a new budget is set, resumes the propagation. The procedures built on top of the propagation (e.g., `check()`, `backbone()` or `enumerate()`) return to their initial decision level.
+     *
+     * @param b the available resources.
+     */
+    inline void set_budget(const sat_budget &b) noexcept
+    {
+      budget = b;
+      n_conflicts = n_propagations = n_pivots = 0;
+      interrupted = false;
+    }
+    inline bool is_interrupted() const noexcept { return interrupted; } // checks whether the last propagation has been interrupted..
+    /**
+     * @brief Get the statistics of the sat core. The counters are not updated if the library is compiled with `NO_STATISTICS`.
+     *
+     * @return const sat_stats& the statistics of the sat core.
+     */
+    inline const sat_stats &get_stats() const noexcept { return stats; }
     /**
      * @brief Check whether the current set of assumptions is satisfiable.
      *
@@ -117,8 +206,55 @@ namespace semitone
     SEMITONE_EXPORT bool propagate() noexcept;
     SEMITONE_EXPORT bool next() noexcept;
     SEMITONE_EXPORT bool check(std::vector<lit> lits) noexcept;
+    /**
+     * @brief Check whether the `lits` assumptions are consistent with the current assignment, returning, if they are not, a subset of them which is responsible for the inconsistency. The subset is obtained by analyzing the final conflict and, if `max_checks` is greater than zero, it is further minimized by removing, one at a time, its literals, within the given number of additional checks. An empty subset means that the current assignment is inconsistent by itself, or that the check has been interrupted.
+     *
+     * @param lits the literals to assume.
+     * @param unsat_core the failed assumptions, if the assumptions are inconsistent.
+     * @param max_checks the maximum number of checks performed for minimizing the failed assumptions.
+     * @return bool `true` if the assumptions are consistent, `false` otherwise.
+     */
+    SEMITONE_EXPORT bool check(const std::vector<lit> &lits, std::vector<lit> &unsat_core, const size_t &max_checks = 0) noexcept;
+    /**
+     * @brief Probe, at root level, both the polarities of the given literals. The failed literals (i.e., those whose assumption leads to a conflict) are negated and asserted at root level, as well as the literals implied by both the polarities of a candidate. The literals implied by each probed literal are cached, and returned by `lookahead()`, until the root level changes or new variables, clauses or theory bindings are added.
+     *
+     * @param cands the literals to probe.
+     * @return bool `false` if the probing detects an inconsistency, `true` otherwise.
+     */
+    SEMITONE_EXPORT bool probe(const std::vector<lit> &cands) noexcept;
+    /**
+     * @brief Compute, at root level, the backbone of the current formula among the `cands` literals, that is, those which are true in every model. The candidates which are false in a found model are discarded, while the remaining ones are checked in chunks, by searching for a model which falsifies at least one of them. Each search is a complete search which includes the checks of the theories, and its learnt clauses are kept for the subsequent ones. The backbone literals are asserted at root level.
+     *
+     * @param cands the candidate literals.
+     * @param out_backbone the candidates which are true in every model.
+     * @param chunk_size the maximum number of candidates checked by each search.
+     * @return bool `false` if the formula has no model or if the search has been interrupted, in which case `is_interrupted()` returns `true` and the candidates found so far are in `out_backbone`, `true` otherwise.
+     */
+    SEMITONE_EXPORT bool backbone(const std::vector<lit> &cands, std::vector<lit> &out_backbone, const size_t &chunk_size = 8) noexcept;
+    /**
+     * @brief Enumerate, at root level, the models of the current formula projected on the `vars` variables, passing each distinct projected assignment to `callback`. The projection variables are decided first, so that each found model is blocked by the negation of the projection decisions only, since the implied projection literals follow from them. The blocking clauses are guarded by a fresh literal which is disabled at the end of the enumeration, hence the formula is left unchanged.
+     *
+     * @param vars the projection variables.
+     * @param callback the function receiving the projected assignments, which can stop the enumeration by returning `false`.
+     * @param limit the maximum number of projected assignments to enumerate.
+     * @return size_t the number of enumerated projected assignments.
+     */
+    SEMITONE_EXPORT size_t enumerate(const std::vector<var> &vars, const std::function<bool(const std::vector<lit> &)> &callback, const size_t &limit = std::numeric_limits<size_t>::max()) noexcept;
+    /**
+     * @brief Compute, at root level, the literals implied by the assumption of `p`, probing `p` if no valid cached result is available.
+     *
+     * @param p the literal whose consequences are required.
+     * @param implied the literals implied by `p`, including `p` itself.
+     * @return bool `false` if `p` is inconsistent with the root level, `true` otherwise.
+     */
+    SEMITONE_EXPORT bool lookahead(const lit &p, std::vector<lit> &implied) noexcept;
 
-    inline utils::lbool value(const var &x) const noexcept { return assigns.at(x); } // returns the value of variable `x`..
+    inline utils::lbool value(const var &x) const noexcept { return is_undefined(substs[x]) ? assigns[x] : value(substs[x]); } // returns the value of variable `x`, possibly through the (never substituted) literal which replaced it..
+    inline lit representative(const lit &p) const noexcept
+    {
+      const auto &s = substs[variable(p)];
+      return is_undefined(s) ? p : (sign(p) ? s : !s);
+    } // returns the literal which replaced literal `p`, or `p` itself if not substituted..
     inline utils::lbool value(const lit &p) const noexcept
     {
       switch (value(variable(p)))
@@ -136,6 +272,9 @@ namespace semitone
     SEMITONE_EXPORT const std::vector<lit> &get_decisions() const noexcept { return decisions; } // returns the decisions taken so far in chronological order..
 
   private:
+    inline utils::lbool assigned(const lit &p) const noexcept { return assigns[variable(p)] == utils::Undefined ? utils::Undefined : (assigns[variable(p)] == sign(p) ? utils::True : utils::False); } // returns the value of literal `p`, which must not be substituted, for propagation purposes..
+    void to_representatives(std::vector<lit> &ls) const noexcept;                                                                                                                                  // replaces the substituted literals with their representatives..
+
     /**
      * @brief Analyze the conflict `cnfl` and return the learnt clause in `out_learnt` and the backtracking level in `out_btlevel`.
      *
@@ -144,14 +283,72 @@ namespace semitone
      * @param out_btlevel the backtracking level.
      */
     void analyze(constr &cnfl, std::vector<lit> &out_learnt, size_t &out_btlevel) noexcept;
+    /**
+     * @brief Analyze the conflict represented by the `n_lits` literals starting at `cnfl`, all of which are false, and return the learnt clause in `out_learnt` and the backtracking level in `out_btlevel`. Differently from the constraint-based analysis, no constraint has to be created (and watched) for representing the conflict.
+     *
+     * @param cnfl the first literal of the conflict to analyze.
+     * @param n_lits the number of literals of the conflict.
+     * @param out_learnt the learnt clause.
+     * @param out_btlevel the backtracking level.
+     */
+    void analyze(const lit *cnfl, const size_t &n_lits, std::vector<lit> &out_learnt, size_t &out_btlevel) noexcept;
+    /**
+     * @brief Analyze the conflict whose reason (i.e., the negation of the conflicting literals) is `p_reason` and return the learnt clause in `out_learnt` and the backtracking level in `out_btlevel`.
+     *
+     * @param p_reason the reason of the conflict.
+     * @param out_learnt the learnt clause.
+     * @param out_btlevel the backtracking level.
+     */
+    void analyze_reason(std::vector<lit> p_reason, std::vector<lit> &out_learnt, size_t &out_btlevel) noexcept;
+    /**
+     * @brief Assume the `lits` literals, starting from the current decision level, returning `false` and the failed assumptions in `out_failed` if they are inconsistent. Each assumption gets its own decision level, hence the caller is responsible for popping them.
+     *
+     * @param lits the literals to assume.
+     * @param out_failed the failed assumptions.
+     * @return bool `true` if the assumptions are consistent, `false` otherwise.
+     */
+    bool assume_all(const std::vector<lit> &lits, std::vector<lit> &out_failed) noexcept;
+    /**
+     * @brief Search, starting from the root level, for a model of the current formula which satisfies the `lits` assumptions, assuming each of them at its own decision level and then deciding the unassigned variables as false, starting from the `prefs` ones. If a model is found, the caller is responsible for popping the decisions.
+     *
+     * @param lits the literals to assume.
+     * @param prefs the variables to decide first.
+     * @return utils::lbool `utils::True` if a model is found, `utils::False` if the assumptions are inconsistent, `utils::Undefined` if the search has been interrupted, returning to the root level, or if the formula is inconsistent by itself, in which case the sat core should not be used anymore.
+     */
+    utils::lbool solve(const std::vector<lit> &lits, const std::vector<var> &prefs = {}) noexcept;
+    /**
+     * @brief Collect, in `out_failed`, the assumptions above decision level `c_rl` which imply the negation of the assumption `p`, along with `p` itself.
+     *
+     * @param p the assumption which is false.
+     * @param c_rl the decision level at which the assumptions started.
+     * @param out_failed the failed assumptions.
+     */
+    void analyze_final(const lit &p, const size_t &c_rl, std::vector<lit> &out_failed) noexcept;
     void record(std::vector<lit> lits) noexcept;
 
+    bool propagate_queue() noexcept; // propagates the queued literals through the constraints and the theories, analyzing the conflicts, if any..
+    void notify_listeners() noexcept; // delivers the pending notifications to the batched listeners..
+
     bool enqueue(const lit &p, constr *const c = nullptr) noexcept;
     void pop_one() noexcept;
+    void backjump(const size_t &bt_level) noexcept; // backtracks, after a conflict, to the `bt_level` decision level, or to the previous decision level if chronological backtracking applies..
+    bool requeue() noexcept;                         // re-enqueues the unassigned literals implied below the current decision level by chronological backtracking, returning `true` if any..
+    bool within_budget(const size_t &pivots = 0) noexcept; // accounts for the given pivots, returning `false`, and marking the core as interrupted, if some resource is exhausted or an interruption is requested..
+    void remove_detached() noexcept; // removes the detached constraints, sweeping once the affected watch lists and the reasons..
+    bool probe_lit(const lit &p, std::vector<lit> &implied, bool &failed) noexcept; // probes literal `p` at root level, asserting its negation if it is a failed literal, returning `false` if the root level is inconsistent..
 
-    inline void bind(const var &v, theory &th) noexcept { bounds[v].insert(&th); }
+    inline void bind(const var &v, theory &th) noexcept
+    {
+      assert(!eliminated[v]);
+      frozen[v] = true;
+      bounds[v].insert(&th);
+      if (!lookaheads.empty()) // the theory might propagate `v`, hence the cached lookaheads might miss some consequences..
+        lookaheads.clear();
+    }
     inline void listen(const var &v, sat_value_listener &l) noexcept
     {
+      assert(!eliminated[v]);
+      frozen[v] = true;
       if (value(v) == utils::Undefined)
         listening[v].insert(&l);
     }
@@ -170,11 +367,24 @@ namespace semitone
     std::vector<constr *> reason;               // for each variable, the constraint that implied its value..
     std::vector<size_t> level;                  // for each variable, the decision level it was assigned..
     std::unordered_map<std::string, lit> exprs; // the already existing expressions (string to literal)..
+    std::vector<bool> frozen;                   // for each variable, whether it is protected from elimination..
+    std::vector<bool> eliminated;               // for each variable, whether it has been eliminated..
+    std::vector<std::vector<lit>> elim_stack;   // the clauses removed by the variable elimination, each one starting with the literal of the eliminated variable, for extending the models..
+    std::vector<lit> substs;                    // for each variable, the literal equivalent to it which replaced it, if any..
+    std::unordered_map<size_t, std::vector<lit>> lookaheads; // for each probed literal (index), the literals it implies at root level..
+    size_t lookaheads_root = 0;                               // the size of the root-level trail the cached lookaheads refer to..
 
     std::vector<theory *> theories; // all the theories..
     std::unordered_map<size_t, std::set<theory *>> bounds;
     std::vector<sat_value_listener *> listeners; // all the listeners..
     std::unordered_map<size_t, std::set<sat_value_listener *>> listening;
+    bool propagating = false; // whether the core is propagating, hence the notifications to the batched listeners are deferred..
+    size_t chrono_threshold = std::numeric_limits<size_t>::max(); // the backjumps retracting more decision levels than this are replaced by chronological backtracking..
+    std::vector<std::tuple<lit, constr *, size_t>> missed;       // the literals assigned, because of chronological backtracking, above the decision level at which their reason implies them, along with their reason and such level..
+    sat_budget budget;                                           // the available resources..
+    size_t n_conflicts = 0, n_propagations = 0, n_pivots = 0;    // the resources consumed since the budget has been set..
+    bool interrupted = false;                                    // whether the last propagation has been interrupted..
+    sat_stats stats;                                             // the statistics of the sat core..
   };
 
 } // namespace semitone
\ No newline at end of file
@@ -3,6 +3,8 @@
 
 #include "sat_core.h"
 #include <algorithm>
+#include <unordered_map>
+#include <vector>
 
 namespace semitone
 {
@@ -14,7 +16,7 @@ namespace semitone
     friend class sat_stack;
 
   public:
-    sat_value_listener(sat_ptr s) : sat(s) { sat->listeners.push_back(this); }
+    sat_value_listener(sat_ptr s, const bool batched = false) : sat(s), batched(batched) { sat->listeners.push_back(this); }
     sat_value_listener(const sat_value_listener &that) = delete;
     virtual ~sat_value_listener() { sat->listeners.erase(std::find(sat->listeners.cbegin(), sat->listeners.cend(), this)); }
 
@@ -23,8 +25,34 @@ namespace semitone
 
   private:
     virtual void sat_value_change(const var &) {}
+    virtual void sat_values_change(const std::vector<var> &) {} // called, for batched listeners, at the end of each propagation and of each backtracking step with the variables whose value has changed since the last notification..
+
+    inline void value_change(const var &v, const utils::lbool &old_val) noexcept
+    {
+      if (!batched)
+        sat_value_change(v);
+      else if (pending_vals.emplace(v, old_val).second) // we store the value the variable had at the last notification..
+        pending_vars.push_back(v);
+    }
+
+    inline void notify() noexcept
+    {
+      if (pending_vars.empty())
+        return;
+      std::vector<var> c_vars;
+      for (const auto &v : pending_vars)
+        if (sat->value(v) != pending_vals.at(v)) // the variable might have been restored to its previous value..
+          c_vars.push_back(v);
+      pending_vars.clear();
+      pending_vals.clear();
+      if (!c_vars.empty())
+        sat_values_change(c_vars);
+    }
 
   private:
     sat_ptr sat;
+    const bool batched;                                 // whether the notifications are deferred and delivered in batches..
+    std::vector<var> pending_vars;                      // the variables changed since the last notification, in chronological order..
+    std::unordered_map<var, utils::lbool> pending_vals; // the values of the changed variables at the last notification..
   };
 } // namespace semitone
\ No newline at end of file
@@ -2,7 +2,9 @@
 
 #include "lit.h"
 #include "memory.h"
+#include "json.hpp"
 #include <vector>
+#include <chrono>
 
 namespace semitone
 {
@@ -10,6 +12,15 @@ namespace semitone
   using sat_ptr = utils::c_ptr<sat_core>;
   class sat_stack;
 
+  /**
+   * @brief The number of calls of the methods of a theory invoked by the sat core, along with the time spent in them.
+   */
+  struct theory_stats
+  {
+    size_t propagates = 0, checks = 0, pushes = 0, pops = 0;
+    std::chrono::steady_clock::duration propagate_time{}, check_time{}, push_time{}, pop_time{};
+  };
+
   class theory
   {
     friend class sat_core;
@@ -29,11 +40,20 @@ namespace semitone
     inline const sat_core &get_sat_core() const noexcept { return *sat; }
     inline sat_ptr &get_sat_core_ptr() noexcept { return sat; }
 
+    /**
+     * @brief Get the statistics of the calls the sat core makes to this theory. The counters and the timers are not updated if the library is compiled with `NO_STATISTICS`.
+     *
+     * @return const theory_stats& the statistics of this theory.
+     */
+    inline const theory_stats &get_theory_stats() const noexcept { return th_stats; }
+
   protected:
     SEMITONE_EXPORT void bind(const var &v) noexcept;
     SEMITONE_EXPORT void swap_conflict(theory &th) noexcept;
     SEMITONE_EXPORT bool backtrack_analyze_and_backjump() noexcept; // backtracks to the proper level before calling analyze_and_backjump..
     SEMITONE_EXPORT void record(std::vector<lit> clause) noexcept;
+    SEMITONE_EXPORT bool within_budget(const size_t &pivots = 0) noexcept; // charges the given pivots to the sat core's budget, returning `false` if the search has to be interrupted..
+    SEMITONE_EXPORT bool is_propagating() const noexcept;                  // checks whether the sat core is propagating, hence whether the notifications to the listeners can be deferred to the end of the propagation..
 
   private:
     /**
@@ -68,5 +88,10 @@ namespace semitone
   protected:
     sat_ptr sat;
     std::vector<lit> cnfl;
+
+  private:
+    theory_stats th_stats; // updated by the sat core..
   };
+
+  SEMITONE_EXPORT json::json to_json(const theory_stats &rhs) noexcept;
 } // namespace semitone
\ No newline at end of file
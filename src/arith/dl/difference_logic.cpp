@@ -0,0 +1,1264 @@
+#include "difference_logic.h"
+#include "dl_value_listener.h"
+#include <algorithm>
+#include <queue>
+#include <tuple>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <stdexcept>
+#include <cassert>
+
+namespace semitone
+{
+    /**
+     * A pool of threads, each running its chunk of the current job, along with the calling thread.
+     */
+    template <typename Weight>
+    class difference_logic<Weight>::workers
+    {
+    public:
+        workers(const size_t &n_threads)
+        {
+            for (size_t id = 1; id < n_threads; ++id)
+                threads.emplace_back([this, id]
+                                     { work(id); });
+        }
+        ~workers()
+        {
+            {
+                std::lock_guard<std::mutex> lock(mtx);
+                stop = true;
+            }
+            start.notify_all();
+            for (auto &t : threads)
+                t.join();
+        }
+
+        size_t size() const noexcept { return threads.size() + 1; }
+
+        void run(const std::function<void(const size_t &)> &f) noexcept
+        {
+            {
+                std::lock_guard<std::mutex> lock(mtx);
+                job = &f;
+                pending = threads.size();
+                ++generation;
+            }
+            start.notify_all();
+            f(0); // the calling thread runs the first chunk..
+            std::unique_lock<std::mutex> lock(mtx);
+            done.wait(lock, [this]
+                      { return pending == 0; });
+        }
+
+    private:
+        void work(const size_t &id)
+        {
+            size_t c_generation = 0;
+            while (true)
+            {
+                std::unique_lock<std::mutex> lock(mtx);
+                start.wait(lock, [this, &c_generation]
+                           { return stop || generation != c_generation; });
+                if (stop)
+                    return;
+                c_generation = generation;
+                const auto f = job;
+                lock.unlock();
+                (*f)(id);
+                lock.lock();
+                if (--pending == 0)
+                    done.notify_one();
+            }
+        }
+
+    private:
+        std::vector<std::thread> threads;
+        std::mutex mtx;
+        std::condition_variable start, done;
+        const std::function<void(const size_t &)> *job = nullptr;
+        size_t generation = 0, pending = 0;
+        bool stop = false;
+    };
+
+    template <typename Weight>
+    difference_logic<Weight>::difference_logic(sat_ptr sat, const size_t &size, const bool sparse) : theory(std::move(sat)), sparse(sparse), from_constrs(1), to_constrs(1), rg_parents(1, 0), rg_offs(1, traits::zero()), rg_ups(1), rg_downs(1), rg_members(1, std::vector<var>(1, 0))
+    {
+        if (sparse)
+        { // we only store the constraint graph (the origin has no edges yet)..
+            pots.reserve(size);
+            out_edges.reserve(size);
+            in_edges.reserve(size);
+            pots.emplace_back(traits::zero());
+            out_edges.emplace_back();
+            in_edges.emplace_back();
+            origin_fwd.emplace_back(traits::zero());
+            origin_bwd.emplace_back(traits::zero());
+            return;
+        }
+
+        col_stamps.resize(size, 0);
+        _dists = std::vector<std::vector<Weight>>(size, std::vector<Weight>(size, inf()));
+        _preds = std::vector<std::vector<var>>(size, std::vector<var>(size, std::numeric_limits<size_t>::max()));
+        _reasons = std::vector<std::vector<lit>>(size, std::vector<lit>(size));
+        _stamps = std::vector<std::vector<uint32_t>>(size, std::vector<uint32_t>(size, 0));
+        for (size_t i = 0; i < size; ++i)
+        {
+            _dists[i][i] = traits::zero();
+            std::fill(_preds[i].begin(), _preds[i].end(), i);
+            _preds[i][i] = std::numeric_limits<size_t>::max();
+        }
+    }
+    template <typename Weight>
+    difference_logic<Weight>::difference_logic(sat_ptr sat, const difference_logic &orig) : theory(std::move(sat)), sparse(orig.sparse), n_vars(orig.n_vars), _dists(orig._dists), _preds(orig._preds), _reasons(orig._reasons), _stamps(orig._stamps), layers(orig.layers), cells_trail(orig.cells_trail), from_constrs(orig.from_constrs.size()), to_constrs(orig.to_constrs.size()), col_stamps(orig.col_stamps), c_stamp(orig.c_stamp), prop_budget(orig.prop_budget), listening(orig.listening), rg_parents(orig.rg_parents), rg_offs(orig.rg_offs), rg_ups(orig.rg_ups), rg_downs(orig.rg_downs), rg_members(orig.rg_members), rg_trail(orig.rg_trail), pool(orig.pool ? new workers(orig.pool->size()) : nullptr), par_threshold(orig.par_threshold), pots(orig.pots), out_edges(orig.out_edges), in_edges(orig.in_edges), edges_trail(orig.edges_trail), origin_fwd(orig.origin_fwd), origin_bwd(orig.origin_bwd), origin_trail(orig.origin_trail)
+    {
+        for (const auto &[v, d] : orig.var_dists)
+            var_dists.emplace(v, new dl_distance(d->b, d->from, d->to, d->dist));
+        for (size_t v = 0; v < orig.from_constrs.size(); ++v)
+        {
+            for (const auto &d : orig.from_constrs[v])
+                from_constrs[v].emplace_back(var_dists.at(variable(d->b)));
+            for (const auto &d : orig.to_constrs[v])
+                to_constrs[v].emplace_back(var_dists.at(variable(d->b)));
+        }
+    }
+    template <typename Weight>
+    difference_logic<Weight>::~difference_logic()
+    {
+        for ([[maybe_unused]] const auto &[v, d] : var_dists)
+            delete d;
+    }
+
+    template <typename Weight>
+    var difference_logic<Weight>::new_var() noexcept
+    {
+        var tp = n_vars++;
+        from_constrs.emplace_back();
+        to_constrs.emplace_back();
+        rg_parents.emplace_back(tp);
+        rg_offs.emplace_back(traits::zero());
+        rg_ups.emplace_back();
+        rg_downs.emplace_back();
+        rg_members.emplace_back(1, tp);
+        if (sparse)
+        { // the new variable has no edges, hence any potential is feasible and it is not connected to the origin..
+            pots.emplace_back(traits::zero());
+            out_edges.emplace_back();
+            in_edges.emplace_back();
+            origin_fwd.emplace_back(inf());
+            origin_bwd.emplace_back(inf());
+        }
+        else if (_dists.size() == tp)
+            resize((_dists.size() * 3) / 2 + 1);
+        return tp;
+    }
+
+    template <typename Weight>
+    lit difference_logic<Weight>::new_distance(const var &from, const var &to, const Weight &dist) noexcept
+    {
+        // in sparse mode, the searches only need to establish whether the distances exceed the ones of the constraint..
+        if (const auto c_dist = sparse ? std::make_pair(-sp_dist(to, from, -dist), sp_dist(from, to, dist)) : distance(from, to); c_dist.first > dist)
+            return FALSE_lit; // the constraint is inconsistent..
+        else if (c_dist.second <= dist)
+            return TRUE_lit; // the constraint is redundant..
+        else
+        { // we need to create a new propositional variable..
+            const auto ctr = sat->new_var();
+            const lit ctr_lit(ctr);
+            bind(ctr);
+            const auto dst_cnst = new dl_distance(ctr_lit, from, to, dist);
+            var_dists.emplace(ctr, dst_cnst);
+            from_constrs[from].emplace_back(dst_cnst);
+            to_constrs[to].emplace_back(dst_cnst);
+            return ctr_lit;
+        }
+    }
+
+    template <typename Weight>
+    lit difference_logic<Weight>::new_lt(const lin &left, const lin &right)
+    {
+        lin expr = left - right;
+        switch (expr.vars.size())
+        {
+        case 0:
+            return expr.known_term < utils::rational::ZERO ? TRUE_lit : FALSE_lit;
+        case 1:
+            if (expr.vars.cbegin()->second < utils::rational::ZERO)
+            {
+                expr = expr / expr.vars.cbegin()->second;
+                return new_distance(expr.vars.cbegin()->first, 0, traits::lt_bound(expr.known_term));
+            }
+            else
+            {
+                expr = expr / expr.vars.cbegin()->second;
+                return new_distance(0, expr.vars.cbegin()->first, traits::lt_bound(-expr.known_term));
+            }
+        case 2:
+            if (expr.vars.cbegin()->second < utils::rational::ZERO)
+            {
+                expr = expr / expr.vars.cbegin()->second;
+                auto it = expr.vars.cbegin();
+                const auto [v0, c0] = *it++;
+                assert(c0 == utils::rational::ONE);
+                const auto [v1, c1] = *it;
+                if (c1 != -utils::rational::ONE)
+                    throw std::invalid_argument("not a valid difference logic constraint..");
+                return new_distance(v0, v1, traits::lt_bound(expr.known_term));
+            }
+            else
+            {
+                expr = expr / expr.vars.cbegin()->second;
+                auto it = expr.vars.cbegin();
+                const auto [v0, c0] = *it++;
+                assert(c0 == utils::rational::ONE);
+                const auto [v1, c1] = *it;
+                if (c1 != -utils::rational::ONE)
+                    throw std::invalid_argument("not a valid difference logic constraint..");
+                return new_distance(v1, v0, traits::lt_bound(-expr.known_term));
+            }
+        default:
+            throw std::invalid_argument("not a valid difference logic constraint..");
+        }
+    }
+
+    template <typename Weight>
+    lit difference_logic<Weight>::new_leq(const lin &left, const lin &right)
+    {
+        lin expr = left - right;
+        switch (expr.vars.size())
+        {
+        case 0:
+            return expr.known_term <= utils::rational::ZERO ? TRUE_lit : FALSE_lit;
+        case 1:
+            if (expr.vars.cbegin()->second < utils::rational::ZERO)
+            {
+                expr = expr / expr.vars.cbegin()->second;
+                return new_distance(expr.vars.cbegin()->first, 0, traits::leq_bound(expr.known_term));
+            }
+            else
+            {
+                expr = expr / expr.vars.cbegin()->second;
+                return new_distance(0, expr.vars.cbegin()->first, traits::leq_bound(-expr.known_term));
+            }
+        case 2:
+            if (expr.vars.cbegin()->second < utils::rational::ZERO)
+            {
+                expr = expr / expr.vars.cbegin()->second;
+                auto it = expr.vars.cbegin();
+                const auto [v0, c0] = *it++;
+                assert(c0 == utils::rational::ONE);
+                const auto [v1, c1] = *it;
+                if (c1 != -utils::rational::ONE)
+                    throw std::invalid_argument("not a valid difference logic constraint..");
+                return new_distance(v0, v1, traits::leq_bound(expr.known_term));
+            }
+            else
+            {
+                expr = expr / expr.vars.cbegin()->second;
+                auto it = expr.vars.cbegin();
+                const auto [v0, c0] = *it++;
+                assert(c0 == utils::rational::ONE);
+                const auto [v1, c1] = *it;
+                if (c1 != -utils::rational::ONE)
+                    throw std::invalid_argument("not a valid difference logic constraint..");
+                return new_distance(v1, v0, traits::leq_bound(-expr.known_term));
+            }
+        default:
+            throw std::invalid_argument("not a valid difference logic constraint..");
+        }
+    }
+
+    template <typename Weight>
+    lit difference_logic<Weight>::new_eq(const lin &left, const lin &right)
+    {
+        lin expr = left - right;
+        switch (expr.vars.size())
+        {
+        case 0:
+            return expr.known_term == utils::rational::ZERO ? TRUE_lit : FALSE_lit;
+        case 1:
+        {
+            expr = expr / expr.vars.cbegin()->second;
+            const auto kt = traits::leq_bound(expr.known_term);
+            if (kt != -traits::leq_bound(-expr.known_term))
+                return FALSE_lit; // the known term is not representable (e.g., an integer variable cannot equal a fractional value)..
+            const auto dist = distance(expr.vars.cbegin()->first, 0);
+            if (dist.first <= kt && dist.second >= kt)
+                return sat->new_conj({new_distance(expr.vars.cbegin()->first, 0, kt), new_distance(0, expr.vars.cbegin()->first, -kt)});
+            else
+                return FALSE_lit;
+        }
+        case 2:
+        {
+            expr = expr / expr.vars.cbegin()->second;
+            auto it = expr.vars.cbegin();
+            const auto [v0, c0] = *it++;
+            assert(c0 == utils::rational::ONE);
+            const auto [v1, c1] = *it;
+            if (c1 != -utils::rational::ONE)
+                throw std::invalid_argument("not a valid difference logic constraint..");
+            const auto kt = traits::leq_bound(expr.known_term);
+            if (kt != -traits::leq_bound(-expr.known_term))
+                return FALSE_lit; // the known term is not representable (e.g., an integer variable cannot equal a fractional value)..
+            const auto dist = distance(v0, v1);
+            if (dist.first <= kt && dist.second >= kt)
+                return sat->new_conj({new_distance(v0, v1, kt), new_distance(v1, v0, -kt)});
+            else
+                return FALSE_lit;
+        }
+        default:
+            throw std::invalid_argument("not a valid difference logic constraint..");
+        }
+    }
+
+    template <typename Weight>
+    lit difference_logic<Weight>::new_geq(const lin &left, const lin &right)
+    {
+        lin expr = left - right;
+        switch (expr.vars.size())
+        {
+        case 0:
+            return expr.known_term >= utils::rational::ZERO ? TRUE_lit : FALSE_lit;
+        case 1:
+            if (expr.vars.cbegin()->second < utils::rational::ZERO)
+            {
+                expr = expr / expr.vars.cbegin()->second;
+                return new_distance(0, expr.vars.cbegin()->first, traits::leq_bound(-expr.known_term));
+            }
+            else
+            {
+                expr = expr / expr.vars.cbegin()->second;
+                return new_distance(expr.vars.cbegin()->first, 0, traits::leq_bound(expr.known_term));
+            }
+        case 2:
+            if (expr.vars.cbegin()->second < utils::rational::ZERO)
+            {
+                expr = expr / expr.vars.cbegin()->second;
+                auto it = expr.vars.cbegin();
+                const auto [v0, c0] = *it++;
+                assert(c0 == utils::rational::ONE);
+                const auto [v1, c1] = *it;
+                if (c1 != -utils::rational::ONE)
+                    throw std::invalid_argument("not a valid difference logic constraint..");
+                return new_distance(v1, v0, traits::leq_bound(-expr.known_term));
+            }
+            else
+            {
+                expr = expr / expr.vars.cbegin()->second;
+                auto it = expr.vars.cbegin();
+                const auto [v0, c0] = *it++;
+                assert(c0 == utils::rational::ONE);
+                const auto [v1, c1] = *it;
+                if (c1 != -utils::rational::ONE)
+                    throw std::invalid_argument("not a valid difference logic constraint..");
+                return new_distance(v0, v1, traits::leq_bound(expr.known_term));
+            }
+        default:
+            throw std::invalid_argument("not a valid difference logic constraint..");
+        }
+    }
+
+    template <typename Weight>
+    lit difference_logic<Weight>::new_gt(const lin &left, const lin &right)
+    {
+        lin expr = left - right;
+        switch (expr.vars.size())
+        {
+        case 0:
+            return expr.known_term > utils::rational::ZERO ? TRUE_lit : FALSE_lit;
+        case 1:
+            if (expr.vars.cbegin()->second < utils::rational::ZERO)
+            {
+                expr = expr / expr.vars.cbegin()->second;
+                return new_distance(0, expr.vars.cbegin()->first, traits::lt_bound(-expr.known_term));
+            }
+            else
+            {
+                expr = expr / expr.vars.cbegin()->second;
+                return new_distance(expr.vars.cbegin()->first, 0, traits::lt_bound(expr.known_term));
+            }
+        case 2:
+            if (expr.vars.cbegin()->second < utils::rational::ZERO)
+            {
+                expr = expr / expr.vars.cbegin()->second;
+                auto it = expr.vars.cbegin();
+                const auto [v0, c0] = *it++;
+                assert(c0 == utils::rational::ONE);
+                const auto [v1, c1] = *it;
+                if (c1 != -utils::rational::ONE)
+                    throw std::invalid_argument("not a valid difference logic constraint..");
+                return new_distance(v1, v0, traits::lt_bound(-expr.known_term));
+            }
+            else
+            {
+                expr = expr / expr.vars.cbegin()->second;
+                auto it = expr.vars.cbegin();
+                const auto [v0, c0] = *it++;
+                assert(c0 == utils::rational::ONE);
+                const auto [v1, c1] = *it;
+                if (c1 != -utils::rational::ONE)
+                    throw std::invalid_argument("not a valid difference logic constraint..");
+                return new_distance(v0, v1, traits::lt_bound(expr.known_term));
+            }
+        default:
+            throw std::invalid_argument("not a valid difference logic constraint..");
+        }
+    }
+
+    template <typename Weight>
+    std::pair<Weight, Weight> difference_logic<Weight>::bounds(const lin &l) const
+    {
+        switch (l.vars.size())
+        {
+        case 0:
+            return std::make_pair(traits::to_weight(l.known_term), traits::to_weight(l.known_term));
+        case 1:
+        {
+            auto it = l.vars.cbegin();
+            const auto kt = traits::to_weight(l.known_term);
+            return std::make_pair(traits::scale(lb(it->first), it->second) + kt, traits::scale(ub(it->first), it->second) + kt);
+        }
+        case 2:
+        {
+            const auto expr = l / l.vars.cbegin()->second;
+            auto it = expr.vars.cbegin();
+            [[maybe_unused]] const auto [v0, c0] = *it++;
+            const auto [v1, c1] = *it;
+            if (c1 != -utils::rational::ONE)
+                throw std::invalid_argument("not a valid difference logic expression..");
+            const auto kt = traits::to_weight(expr.known_term);
+            const auto dist = distance(v1, v0);
+            return std::make_pair(dist.first + kt, dist.second + kt);
+        }
+        default:
+            throw std::invalid_argument("not a valid difference logic expression..");
+        }
+    }
+
+    template <typename Weight>
+    std::pair<Weight, Weight> difference_logic<Weight>::distance(const lin &from, const lin &to) const
+    {
+        lin expr = from - to;
+        switch (expr.vars.size())
+        {
+        case 0:
+            return std::make_pair(traits::to_weight(expr.known_term), traits::to_weight(expr.known_term));
+        case 1:
+        {
+            expr = expr / expr.vars.cbegin()->second;
+            traits::to_weight(expr.known_term); // the known term must be representable..
+            return distance(expr.vars.cbegin()->first, 0);
+        }
+        case 2:
+        {
+            expr = expr / expr.vars.cbegin()->second;
+            auto it = expr.vars.cbegin();
+            const auto [v0, c0] = *it++;
+            assert(c0 == utils::rational::ONE);
+            const auto [v1, c1] = *it;
+            if (c1 != -utils::rational::ONE)
+                throw std::invalid_argument("not a valid difference logic constraint..");
+            traits::to_weight(expr.known_term); // the known term must be representable..
+            return distance(v0, v1);
+        }
+        default:
+            throw std::invalid_argument("not a valid difference logic constraint..");
+        }
+    }
+
+    template <typename Weight>
+    bool difference_logic<Weight>::matches(const lin &l0, const lin &l1) const
+    {
+        if (l0.vars.empty() && l1.vars.empty())
+            return l0.known_term == l1.known_term;
+        else if (l0.vars.empty() && l1.vars.size() == 1)
+        {
+            const auto [lb, ub] = bounds(l1);
+            return traits::to_inf_rational(lb) <= utils::inf_rational(l0.known_term) && traits::to_inf_rational(ub) >= utils::inf_rational(l0.known_term);
+        }
+        else if (l0.vars.size() == 1 && l1.vars.empty())
+        {
+            const auto [lb, ub] = bounds(l0);
+            return traits::to_inf_rational(lb) <= utils::inf_rational(l1.known_term) && traits::to_inf_rational(ub) >= utils::inf_rational(l1.known_term);
+        }
+        else if (l0.vars.size() == 1 && l1.vars.size() == 1)
+        {
+            const auto [lb, ub] = distance(l0.vars.cbegin()->first, l1.vars.cbegin()->first);
+            const auto kt = utils::inf_rational(l0.known_term - l1.known_term);
+            return traits::to_inf_rational(lb) + kt <= utils::inf_rational(utils::rational::ZERO) && traits::to_inf_rational(ub) + kt >= utils::inf_rational(utils::rational::ZERO);
+        }
+        else
+            throw std::invalid_argument("not a valid comparison between difference logic expressions..");
+    }
+
+    template <typename Weight>
+    bool difference_logic<Weight>::propagate(const lit &p) noexcept
+    {
+        assert(cnfl.empty());
+        assert(var_dists.count(variable(p)));
+
+        const auto &dist = var_dists.at(variable(p));
+        if (sparse)
+        { // we add the corresponding edge to the constraint graph..
+            const auto [from, to, d] = sat->value(dist->b) == utils::True ? std::make_tuple(dist->from, dist->to, dist->dist) : std::make_tuple(dist->to, dist->from, -dist->dist - traits::epsilon());
+            if (!sp_add_edge(from, to, d, p))
+            {
+                cnfl.emplace_back(!p);
+                return false;
+            }
+            sp_propagate(from, to, d, p);
+            return true;
+        }
+        switch (sat->value(dist->b))
+        {
+        case utils::True: // the assertion is direct..
+            if (dense_dist(dist->to, dist->from) < -dist->dist)
+            { // we build the cause for the conflict..
+                explain(dist->to, dist->from);
+                cnfl.emplace_back(!p);
+                return false;
+            }
+            else if (dense_dist(dist->from, dist->to) > dist->dist) // we propagate..
+                propagate(dist->from, dist->to, dist->dist, p);
+            break;
+        case utils::False: // the assertion is negated (semantic branching)..
+            if (dense_dist(dist->from, dist->to) <= dist->dist)
+            { // we build the cause for the conflict..
+                explain(dist->from, dist->to);
+                cnfl.emplace_back(!p);
+                return false;
+            }
+            else if (dense_dist(dist->to, dist->from) >= -dist->dist) // we propagate..
+                propagate(dist->to, dist->from, -dist->dist - traits::epsilon(), p);
+            break;
+        }
+        return true;
+    }
+
+    template <typename Weight>
+    bool difference_logic<Weight>::check() noexcept
+    {
+        assert(cnfl.empty());
+        assert(sparse || std::all_of(var_dists.cbegin(), var_dists.cend(), [this](const auto &dist)
+                                     {
+                               switch (sat->value(dist.second->b))
+                               {
+                               case utils::True: // the constraint is asserted..
+                                   return dense_dist(dist.second->from, dist.second->to) <= dist.second->dist;
+                               case utils::False: // the constraint is negated..
+                                   return dense_dist(dist.second->to, dist.second->from) < -dist.second->dist;
+                               default: // the constraint is not asserted..
+                                   return true;
+                               } }));
+        notify_batched();
+        return true;
+    }
+
+    template <typename Weight>
+    void difference_logic<Weight>::push() noexcept { layers.push_back({cells_trail.size(), edges_trail.size(), rg_trail.size(), origin_trail.size()}); }
+
+    template <typename Weight>
+    void difference_logic<Weight>::pop() noexcept
+    {
+        std::vector<var> restored; // the listened variables whose bounds are restored..
+
+        // we remove the edges added since the last push (notice that the potential function remains feasible)..
+        while (edges_trail.size() > layers.back().n_edges)
+        {
+            const auto [from, to] = edges_trail.back();
+            out_edges[from].pop_back();
+            in_edges[to].pop_back();
+            edges_trail.pop_back();
+        }
+
+        // we restore the distances from and to the origin, in reverse chronological order..
+        while (origin_trail.size() > layers.back().n_origin)
+        {
+            const auto &[v, forward, dist] = origin_trail.back();
+            (forward ? origin_fwd : origin_bwd)[v] = dist;
+            if (!listening.empty())
+                restored.emplace_back(v);
+            origin_trail.pop_back();
+        }
+
+        // we restore the updated cells, in reverse chronological order..
+        if (cells_trail.size() > layers.back().n_cells)
+            expls.clear(); // the shortest paths are about to change..
+        const var origin = rg_rep(0); // the component of the origin includes the ones it had since the last push..
+        std::vector<var> r_restored;  // the representatives whose distance from, or to, the origin is restored..
+        while (cells_trail.size() > layers.back().n_cells)
+        {
+            const auto &c = cells_trail.back();
+            if (!listening.empty())
+            {
+                if (rg_rep(c.from) == origin)
+                    r_restored.emplace_back(rg_rep(c.to));
+                else if (rg_rep(c.to) == origin)
+                    r_restored.emplace_back(rg_rep(c.from));
+            }
+            _dists[c.from][c.to] = c.dist;
+            _preds[c.from][c.to] = c.pred;
+            _reasons[c.from][c.to] = c.reason;
+            _stamps[c.from][c.to] = c.stamp;
+            cells_trail.pop_back();
+        }
+
+        // the bounds of all the members of the components are restored, including the ones which are about to be split..
+        std::sort(r_restored.begin(), r_restored.end());
+        r_restored.erase(std::unique(r_restored.begin(), r_restored.end()), r_restored.end());
+        for (const auto &r : r_restored)
+            restored.insert(restored.cend(), rg_members[r].cbegin(), rg_members[r].cend());
+
+        // we split the rigid components merged since the last push..
+        while (rg_trail.size() > layers.back().n_merges)
+        {
+            const auto [x, c] = rg_trail.back();
+            rg_parents[x] = x;
+            rg_members[c].resize(rg_members[c].size() - rg_members[x].size());
+            rg_trail.pop_back();
+        }
+        layers.pop_back();
+
+        // we notify the listeners that the bounds have been restored..
+        std::sort(restored.begin(), restored.end());
+        restored.erase(std::unique(restored.begin(), restored.end()), restored.end());
+        for (const auto &v : restored)
+            notify(v);
+    }
+
+    template <typename Weight>
+    void difference_logic<Weight>::propagate(const var &from, const var &to, const Weight &dist, const lit &reason) noexcept
+    {
+        assert(-inf() < dist && dist < inf());
+        SEMITONE_STATS(++stats.edges);
+        expls.clear(); // the shortest paths are about to change..
+        if (++c_stamp == 0)
+        { // the stamps have wrapped around..
+            std::fill(col_stamps.begin(), col_stamps.end(), 0);
+            c_stamp = 1;
+        }
+        // we relax the edge between the representatives of `from` and `to`..
+        const auto c_from = rg_find(from);
+        const auto c_to = rg_find(to);
+        const var r_from = c_from.first, r_to = c_to.first;
+        assert(r_from != r_to);
+        const Weight r_dist = dist + c_from.second - c_to.second;
+        std::vector<var> set_i;
+        std::vector<var> set_j;
+        std::vector<var> changed;
+        std::vector<std::pair<var, var>> updated;
+        const auto collect = [this, &set_i, &set_j, &changed, &updated](const size_t &n_chunks)
+        {
+            for (size_t k = 0; k < n_chunks; ++k)
+            {
+                set_i.insert(set_i.cend(), chunks[k].rows.cbegin(), chunks[k].rows.cend());
+                set_j.insert(set_j.cend(), chunks[k].cols.cbegin(), chunks[k].cols.cend());
+                changed.insert(changed.cend(), chunks[k].changed.cbegin(), chunks[k].changed.cend());
+                updated.insert(updated.cend(), chunks[k].updated.cbegin(), chunks[k].updated.cend());
+            }
+        };
+
+        collect(relax(1, 1, [this, &from, &r_from, &r_to, &r_dist, &reason](relaxation &rl, const size_t &, const size_t &)
+                      {
+                          set_dist(r_from, r_to, r_dist, rl);
+                          set_pred(r_from, r_to, from, reason); }));
+
+        // we start with an O(n) loop (each iteration only updates the `u -> to` and the `from -> u` cells)..
+        collect(relax(size(), size(), [this, &from, &r_from, &r_to, &r_dist, &reason](relaxation &rl, const size_t &begin, const size_t &end)
+                      {
+                          for (var u = begin; u < end; ++u)
+                          {
+                              if (rg_parents[u] != u)
+                                  continue; // only the representatives are maintained..
+                              if (_dists[u][r_from] != inf() && _dists[u][r_from] < _dists[u][r_to] - r_dist)
+                              { // u -> from -> to is shorter than u -> to..
+                                  set_dist(u, r_to, _dists[u][r_from] + r_dist, rl);
+                                  set_pred(u, r_to, from, reason);
+                                  rl.rows.emplace_back(u);
+                              }
+                              if (_dists[r_to][u] != inf() && _dists[r_to][u] < _dists[r_from][u] - r_dist)
+                              { // from -> to -> u is shorter than from -> u..
+                                  set_dist(r_from, u, _dists[r_to][u] + r_dist, rl);
+                                  set_pred(r_from, u, _preds[r_to][u], _reasons[r_to][u]);
+                                  rl.cols.emplace_back(u);
+                              }
+                          } }));
+
+        // then, we loop over set_i and set_j in O(n^2) time (but possibly much less)..
+        collect(relax(set_i.size(), set_i.size() * set_j.size(), [this, &r_to, &set_i, &set_j](relaxation &rl, const size_t &begin, const size_t &end)
+                      {
+                          for (size_t k = begin; k < end; ++k)
+                          {
+                              const auto &i = set_i[k];
+                              for (const auto &j : set_j)
+                                  if (i != j && _dists[i][r_to] + _dists[r_to][j] < _dists[i][j])
+                                  { // i -> from -> to -> j is shorter than i -> j--
+                                      set_dist(i, j, _dists[i][r_to] + _dists[r_to][j], rl);
+                                      set_pred(i, j, _preds[r_to][j], _reasons[r_to][j]);
+                                  }
+                          } }));
+
+        // we notify the listeners, in the same order as a sequential relaxation, that the bounds of the rigid components have changed..
+        for (const auto &v : changed)
+            for (const auto &m : rg_members[v])
+                notify(m);
+
+        // every updated cell lies in a row of `set_i` (or `from`) and in a column of `set_j` (or `to`), hence we stamp the columns..
+        set_i.emplace_back(r_from);
+        set_j.emplace_back(r_to);
+        for (const auto &j : set_j)
+            col_stamps[j] = c_stamp;
+
+        // .. we check the unassigned constraints whose `from -> to`, or `to -> from`, cell might have been updated..
+        const auto check_constrs = [this, &set_i]()
+        {
+            size_t budget = prop_budget;
+            for (const auto &u : set_i)
+                for (const auto &m : rg_members[u])
+                {
+                    for (const auto &c_dist : from_constrs[m])
+                        if (col_stamps[rg_rep(c_dist->to)] == c_stamp && sat->value(c_dist->b) == utils::Undefined)
+                        {
+                            if (budget-- == 0)
+                                return;
+                            propagate(*c_dist);
+                        }
+                    for (const auto &c_dist : to_constrs[m])
+                        if (col_stamps[rg_rep(c_dist->from)] == c_stamp && sat->value(c_dist->b) == utils::Undefined)
+                        {
+                            if (budget-- == 0)
+                                return;
+                            propagate(*c_dist);
+                        }
+                }
+        };
+        check_constrs();
+
+        // .. and, finally, we collapse the rigid components, looking for the fixed distances among the updated cells only, since a distance becomes fixed when one of its cells is updated..
+        for (const auto &[i, j] : updated)
+            if (_dists[j][i] != inf() && _dists[i][j] + _dists[j][i] == traits::zero())
+                if (const auto r_i = rg_rep(i), r_j = rg_rep(j); r_i != r_j)
+                    rg_merge(r_i, r_j);
+    }
+
+    template <typename Weight>
+    void difference_logic<Weight>::propagate(const dl_distance &c_dist) noexcept
+    {
+        if (dense_dist(c_dist.to, c_dist.from) < -c_dist.dist)
+        { // the constraint is inconsistent..
+            cnfl.emplace_back(!c_dist.b);
+            explain(c_dist.to, c_dist.from);
+            // we propagate the reason for assigning false to dist->b..
+            record(cnfl);
+            cnfl.clear();
+        }
+        else if (dense_dist(c_dist.from, c_dist.to) <= c_dist.dist)
+        { // the constraint is redundant..
+            cnfl.emplace_back(c_dist.b);
+            explain(c_dist.from, c_dist.to);
+            // we propagate the reason for assigning true to dist->b..
+            record(cnfl);
+            cnfl.clear();
+        }
+    }
+
+    template <typename Weight>
+    void difference_logic<Weight>::save(const var &from, const var &to) noexcept
+    {
+        if (!layers.empty() && _stamps[from][to] != layers.size())
+        { // we store the current values, once per level, for backtracking purposes..
+            cells_trail.push_back({from, to, _dists[from][to], _preds[from][to], _reasons[from][to], _stamps[from][to]});
+            _stamps[from][to] = static_cast<uint32_t>(layers.size());
+        }
+    }
+
+    template <typename Weight>
+    void difference_logic<Weight>::set_dist(const var &from, const var &to, const Weight &dist, relaxation &rl) noexcept
+    {
+        assert(_dists[from][to] > dist);
+        if (!layers.empty() && _stamps[from][to] != layers.size())
+        { // we store the current values, once per level, for backtracking purposes..
+            rl.trail.push_back({from, to, _dists[from][to], _preds[from][to], _reasons[from][to], _stamps[from][to]});
+            _stamps[from][to] = static_cast<uint32_t>(layers.size());
+        }
+        // we update the disterence..
+        _dists[from][to] = dist;
+        rl.updated.emplace_back(from, to);
+        SEMITONE_STATS(++rl.n_updates);
+
+        if (const auto origin = rg_rep(0); from == origin)
+            rl.changed.emplace_back(to);
+        else if (to == origin)
+            rl.changed.emplace_back(from);
+    }
+
+    template <typename Weight>
+    size_t difference_logic<Weight>::relax(const size_t &n, const size_t &cells, const std::function<void(relaxation &, const size_t &, const size_t &)> &f) noexcept
+    {
+        const size_t n_chunks = pool && cells >= par_threshold ? std::max<size_t>(1, std::min(pool->size(), n)) : 1;
+        if (chunks.size() < n_chunks)
+            chunks.resize(n_chunks);
+        for (size_t k = 0; k < n_chunks; ++k)
+        {
+            chunks[k].rows.clear();
+            chunks[k].cols.clear();
+            chunks[k].trail.clear();
+            chunks[k].changed.clear();
+            chunks[k].updated.clear();
+            chunks[k].n_updates = 0;
+        }
+
+        if (n_chunks == 1)
+            f(chunks[0], 0, n);
+        else // each thread relaxes a contiguous chunk of items..
+            pool->run([&n, &n_chunks, &f, this](const size_t &k)
+                      { if (k < n_chunks) f(chunks[k], k * n / n_chunks, (k + 1) * n / n_chunks); });
+
+        // we merge the saved cells, in the same order as a sequential relaxation..
+        for (size_t k = 0; k < n_chunks; ++k)
+        {
+            cells_trail.insert(cells_trail.cend(), chunks[k].trail.cbegin(), chunks[k].trail.cend());
+            SEMITONE_STATS(stats.cells += chunks[k].n_updates);
+        }
+        return n_chunks;
+    }
+
+    template <typename Weight>
+    size_t difference_logic<Weight>::get_n_threads() const noexcept { return pool ? pool->size() : 1; }
+
+    template <typename Weight>
+    void difference_logic<Weight>::set_parallelism(const size_t &n_threads, const size_t &threshold)
+    {
+        assert(!sparse);
+        pool.reset(n_threads > 1 ? new workers(n_threads) : nullptr);
+        par_threshold = threshold;
+    }
+
+    template <typename Weight>
+    void difference_logic<Weight>::set_pred(const var &from, const var &to, const var &pred, const lit &reason) noexcept
+    {
+        assert(layers.empty() || _stamps[from][to] == layers.size()); // the cell has been saved by `set_dist`..
+        // we update the predecessor and the literal enforcing the `pred -> to` edge..
+        _preds[from][to] = pred;
+        _reasons[from][to] = reason;
+    }
+
+    template <typename Weight>
+    void difference_logic<Weight>::explain(const var &from, const var &to) noexcept
+    {
+        if (const auto &c_expl = expls.find({from, to}); c_expl != expls.cend())
+        { // the path has already been explained..
+            cnfl.insert(cnfl.cend(), c_expl->second.cbegin(), c_expl->second.cend());
+            return;
+        }
+        const auto c_size = cnfl.size();
+        // the path goes from `from` to its representative, to the representative of `to` and, finally, to `to`..
+        const auto r_from = rg_rep(from);
+        const auto r_to = rg_rep(to);
+        rg_explain(from, true);
+        for (var c_to = r_to; c_to != r_from; c_to = rg_rep(_preds[r_from][c_to]))
+        {
+            if (c_to != r_to)
+                if (const auto &c_expl = expls.find({r_from, c_to}); c_expl != expls.cend())
+                { // the rest of the path has already been explained..
+                    cnfl.insert(cnfl.cend(), c_expl->second.cbegin(), c_expl->second.cend());
+                    break;
+                }
+            const auto &reason = _reasons[r_from][c_to];
+            cnfl.emplace_back(!reason);
+            // the edge might connect two members of the rigid components..
+            rg_explain(_preds[r_from][c_to], false);
+            if (rg_members[c_to].size() > 1)
+            {
+                const auto &c_dist = *var_dists.at(variable(reason));
+                rg_explain(reason == c_dist.b ? c_dist.to : c_dist.from, true);
+            }
+        }
+        rg_explain(to, false);
+        expls.emplace(std::make_pair(from, to), std::vector<lit>(cnfl.cbegin() + c_size, cnfl.cend()));
+    }
+
+    template <typename Weight>
+    void difference_logic<Weight>::resize(const size_t &size) noexcept
+    {
+        const size_t c_size = _dists.size();
+        for (auto &row : _dists)
+            row.resize(size, inf());
+        _dists.resize(size, std::vector<Weight>(size, inf()));
+        for (size_t i = c_size; i < size; ++i)
+            _dists[i][i] = traits::zero();
+
+        for (auto &row : _stamps)
+            row.resize(size, 0);
+        _stamps.resize(size, std::vector<uint32_t>(size, 0));
+        col_stamps.resize(size, 0);
+
+        for (size_t i = 0; i < c_size; ++i)
+            _preds[i].resize(size, i);
+        _preds.resize(size, std::vector<var>(size, std::numeric_limits<size_t>::max()));
+        for (size_t i = c_size; i < size; ++i)
+        {
+            std::fill(_preds[i].begin(), _preds[i].end(), i);
+            _preds[i][i] = std::numeric_limits<size_t>::max();
+        }
+
+        for (auto &row : _reasons)
+            row.resize(size);
+        _reasons.resize(size, std::vector<lit>(size));
+    }
+
+    template <typename Weight>
+    std::pair<var, Weight> difference_logic<Weight>::rg_find(var v) const noexcept
+    {
+        Weight off = traits::zero();
+        for (; rg_parents[v] != v; v = rg_parents[v])
+            off += rg_offs[v];
+        return {v, off};
+    }
+
+    template <typename Weight>
+    void difference_logic<Weight>::rg_merge(const var &a, const var &b) noexcept
+    {
+        assert(rg_parents[a] == a && rg_parents[b] == b);
+        assert(_dists[a][b] + _dists[b][a] == traits::zero());
+        assert(cnfl.empty());
+        // the smaller component is merged into the larger one..
+        const auto [c, x] = rg_members[a].size() >= rg_members[b].size() ? std::make_pair(a, b) : std::make_pair(b, a);
+
+        // we store the explanations of the fixed distance between `c` and `x`..
+        explain(c, x);
+        std::vector<lit> down(cnfl);
+        cnfl.clear();
+        explain(x, c);
+        std::vector<lit> up(cnfl);
+        cnfl.clear();
+
+        // the shortest paths to `c` passing through `x` would pass through `c` itself, hence they are redirected to the last edge of the path to `x`..
+        // the variables between `x` and `c`, along a shortest path, are rigid with `c`, hence each walk stops at the first variable which is not..
+        for (size_t r = 0; r < size(); ++r)
+            if (rg_parents[r] == r && r != c && r != x && _dists[r][c] != inf())
+            {
+                for (var c_to = rg_rep(_preds[r][c]); c_to != r; c_to = rg_rep(_preds[r][c_to]))
+                    if (c_to == x)
+                    {
+                        save(r, c);
+                        _preds[r][c] = _preds[r][x];
+                        _reasons[r][c] = _reasons[r][x];
+                        break;
+                    }
+                    else if (_dists[c_to][c] == inf() || _dists[c][c_to] == inf() || _dists[c_to][c] + _dists[c][c_to] != traits::zero())
+                        break;
+            }
+
+        rg_parents[x] = c;
+        rg_offs[x] = _dists[c][x];
+        rg_ups[x] = std::move(up);
+        rg_downs[x] = std::move(down);
+        rg_members[c].insert(rg_members[c].cend(), rg_members[x].cbegin(), rg_members[x].cend());
+        if (!layers.empty())
+            rg_trail.emplace_back(x, c);
+        expls.clear(); // the representatives have changed..
+    }
+
+    template <typename Weight>
+    void difference_logic<Weight>::rg_explain(var v, const bool up) noexcept
+    {
+        for (; rg_parents[v] != v; v = rg_parents[v])
+            cnfl.insert(cnfl.cend(), up ? rg_ups[v].cbegin() : rg_downs[v].cbegin(), up ? rg_ups[v].cend() : rg_downs[v].cend());
+    }
+
+    template <typename Weight>
+    bool difference_logic<Weight>::sp_add_edge(const var &from, const var &to, const Weight &dist, const lit &reason) noexcept
+    {
+        assert(sparse);
+        assert(cnfl.empty());
+        if (dist + pots[from] - pots[to] < traits::zero())
+        { // the potential function is no more feasible, hence we decrease the potentials of the variables reachable from `to` (Cotton-Maler)..
+            auto &g = c_fwd;
+            for (const auto &v : g.reached)
+            {
+                g.dists[v] = inf();
+                g.settled[v] = false;
+            }
+            g.reached.clear();
+            if (g.dists.size() < n_vars)
+            {
+                g.dists.resize(n_vars, inf());
+                g.preds.resize(n_vars);
+                g.reasons.resize(n_vars);
+                g.settled.resize(n_vars, false);
+            }
+
+            // `g.dists` stores the (negative) potential decrements..
+            std::priority_queue<std::pair<Weight, var>, std::vector<std::pair<Weight, var>>, std::greater<std::pair<Weight, var>>> q;
+            g.dists[to] = dist + pots[from] - pots[to];
+            g.preds[to] = from;
+            g.reasons[to] = reason;
+            g.reached.push_back(to);
+            q.emplace(g.dists[to], to);
+            while (!q.empty())
+            {
+                const auto [c_gamma, u] = q.top();
+                q.pop();
+                if (g.settled[u] || c_gamma > g.dists[u])
+                    continue;
+                g.settled[u] = true;
+                const auto c_pot = pots[u] + c_gamma; // the new potential of `u`..
+                for (const auto &e : out_edges[u])
+                    if (!g.settled[e.to])
+                        if (const auto n_gamma = c_pot + e.dist - pots[e.to]; n_gamma < traits::zero() && n_gamma < g.dists[e.to])
+                        {
+                            if (e.to == from)
+                            { // we have found a negative cycle, hence we build the cause for the conflict..
+                                cnfl.emplace_back(!e.reason);
+                                for (var c_v = u; c_v != to; c_v = g.preds[c_v])
+                                    cnfl.emplace_back(!g.reasons[c_v]);
+                                return false;
+                            }
+                            if (g.dists[e.to] == inf())
+                                g.reached.push_back(e.to);
+                            g.dists[e.to] = n_gamma;
+                            g.preds[e.to] = u;
+                            g.reasons[e.to] = e.reason;
+                            q.emplace(n_gamma, e.to);
+                        }
+            }
+
+            // we commit the new potentials..
+            for (const auto &v : g.reached)
+                pots[v] += g.dists[v];
+            SEMITONE_STATS(stats.cells += g.reached.size());
+        }
+
+        // we add the edge..
+        SEMITONE_STATS(++stats.edges);
+        out_edges[from].push_back({to, dist, reason});
+        in_edges[to].push_back({from, dist, reason});
+        edges_trail.emplace_back(from, to);
+
+        // the bounds change only if the edge shortens the path from the origin to `to`, or the one from `from` to the origin..
+        if (origin_fwd[from] != inf() && origin_fwd[from] + dist < origin_fwd[to])
+            sp_decrease(to, true, origin_fwd[from] + dist);
+        if (origin_bwd[to] != inf() && dist + origin_bwd[to] < origin_bwd[from])
+            sp_decrease(from, false, dist + origin_bwd[to]);
+        return true;
+    }
+
+    template <typename Weight>
+    void difference_logic<Weight>::sp_propagate(const var &from, const var &to, const Weight &dist, const lit &reason) noexcept
+    {
+        assert(sparse);
+        sp_search(from, false, c_bwd, std::numeric_limits<var>::max(), prop_budget); // the distances to `from`..
+        sp_search(to, true, c_fwd, std::numeric_limits<var>::max(), prop_budget);    // the distances from `to`..
+
+        // we explain the `c_from -> from -> to -> c_to` path..
+        const auto explain = [this, &from, &to, &reason](var c_from, var c_to)
+        {
+            for (; c_from != from; c_from = c_bwd.preds[c_from])
+                cnfl.emplace_back(!c_bwd.reasons[c_from]);
+            cnfl.emplace_back(!reason);
+            for (; c_to != to; c_to = c_fwd.preds[c_to])
+                cnfl.emplace_back(!c_fwd.reasons[c_to]);
+        };
+
+        size_t budget = prop_budget; // every visited constraint is accounted, so that the hubs (e.g., the origin) do not escape the budget..
+        for (const auto &u : c_bwd.reached)
+        {
+            for (const auto &c_dist : from_constrs[u])
+            {
+                if (budget-- == 0)
+                    return;
+                if (sat->value(c_dist->b) == utils::Undefined && c_fwd.dists[c_dist->to] != inf() && c_bwd.dists[u] + dist + c_fwd.dists[c_dist->to] <= c_dist->dist)
+                { // the constraint is entailed..
+                    cnfl.emplace_back(c_dist->b);
+                    explain(u, c_dist->to);
+                    // we propagate the reason for assigning true to dist->b..
+                    record(cnfl);
+                    cnfl.clear();
+                }
+            }
+            for (const auto &c_dist : to_constrs[u])
+            {
+                if (budget-- == 0)
+                    return;
+                if (sat->value(c_dist->b) == utils::Undefined && c_fwd.dists[c_dist->from] != inf() && c_bwd.dists[u] + dist + c_fwd.dists[c_dist->from] < -c_dist->dist)
+                { // the constraint is inconsistent..
+                    cnfl.emplace_back(!c_dist->b);
+                    explain(u, c_dist->from);
+                    // we propagate the reason for assigning false to dist->b..
+                    record(cnfl);
+                    cnfl.clear();
+                }
+            }
+        }
+    }
+
+    template <typename Weight>
+    void difference_logic<Weight>::sp_search(const var &source, const bool forward, search &s, const var &target, const size_t &limit, const Weight &bound) const noexcept
+    {
+        assert(sparse);
+        for (const auto &v : s.reached)
+        {
+            s.dists[v] = inf();
+            s.settled[v] = false;
+        }
+        s.reached.clear();
+        if (s.dists.size() < n_vars)
+        {
+            s.dists.resize(n_vars, inf());
+            s.preds.resize(n_vars);
+            s.reasons.resize(n_vars);
+            s.settled.resize(n_vars, false);
+        }
+
+        // we run Dijkstra's algorithm on the (non-negative) reduced costs `dist + pots[from] - pots[to]`..
+        std::priority_queue<std::pair<Weight, var>, std::vector<std::pair<Weight, var>>, std::greater<std::pair<Weight, var>>> q;
+        s.dists[source] = traits::zero();
+        s.reached.push_back(source);
+        q.emplace(traits::zero(), source);
+        size_t n_relaxed = 0;
+        // the distance of `target` exceeds `bound` if its reduced distance exceeds `r_bound`..
+        const bool bounded = target < n_vars && bound != inf();
+        const Weight r_bound = bounded ? bound + (forward ? pots[source] - pots[target] : pots[target] - pots[source]) : inf();
+        while (!q.empty())
+        {
+            const auto [c_dist, u] = q.top();
+            q.pop();
+            if (s.settled[u] || c_dist > s.dists[u])
+                continue;
+            if (bounded && c_dist > r_bound)
+                break;
+            s.settled[u] = true;
+            if (u == target)
+                break;
+            const auto &es = forward ? out_edges[u] : in_edges[u];
+            for (auto e_it = es.cbegin(); e_it != es.cend() && n_relaxed < limit; ++e_it, ++n_relaxed)
+            {
+                const auto &e = *e_it;
+                assert(e.dist + (forward ? pots[u] - pots[e.to] : pots[e.to] - pots[u]) >= traits::zero());
+                if (const auto n_dist = c_dist + e.dist + (forward ? pots[u] - pots[e.to] : pots[e.to] - pots[u]); n_dist < s.dists[e.to])
+                {
+                    if (s.dists[e.to] == inf())
+                        s.reached.push_back(e.to);
+                    s.dists[e.to] = n_dist;
+                    s.preds[e.to] = u;
+                    s.reasons[e.to] = e.reason;
+                    q.emplace(n_dist, e.to);
+                }
+            }
+            if (n_relaxed >= limit)
+                break; // the unsettled variables keep the lengths of the paths found so far..
+        }
+
+        // we translate the reduced distances into actual distances..
+        for (const auto &v : s.reached)
+            s.dists[v] += forward ? pots[v] - pots[source] : pots[source] - pots[v];
+    }
+
+    template <typename Weight>
+    void difference_logic<Weight>::sp_decrease(const var &source, const bool forward, const Weight &dist) noexcept
+    {
+        assert(sparse);
+        auto &dists = forward ? origin_fwd : origin_bwd;
+        // the reduced distances never decrease along the edges, hence each variable is visited once, with its final distance..
+        std::priority_queue<std::pair<Weight, var>, std::vector<std::pair<Weight, var>>, std::greater<std::pair<Weight, var>>> q;
+        const auto set = [this, &forward, &dists, &q](const var &v, const Weight &c_dist)
+        {
+            if (!layers.empty()) // we store the current distance for backtracking purposes..
+                origin_trail.emplace_back(v, forward, dists[v]);
+            dists[v] = c_dist;
+            q.emplace(forward ? c_dist - pots[v] : c_dist + pots[v], v);
+            SEMITONE_STATS(++stats.cells);
+        };
+        set(source, dist);
+        while (!q.empty())
+        {
+            const auto [c_key, u] = q.top();
+            q.pop();
+            if (c_key > (forward ? dists[u] - pots[u] : dists[u] + pots[u]))
+                continue;
+            notify(u); // the distance of `u` is final..
+            for (const auto &e : forward ? out_edges[u] : in_edges[u])
+                if (const auto n_dist = dists[u] + e.dist; n_dist < dists[e.to])
+                    set(e.to, n_dist);
+        }
+    }
+
+    template <typename Weight>
+    Weight difference_logic<Weight>::sp_dist(const var &from, const var &to, const Weight &bound) const noexcept
+    {
+        assert(sparse);
+        if (from == to)
+            return traits::zero();
+        if (from == 0)
+            return origin_fwd[to];
+        if (to == 0)
+            return origin_bwd[from];
+        if (bound != inf() && pots[to] - pots[from] > bound)
+            return inf(); // the potential function bounds the distance from below..
+        sp_search(from, true, c_query, to, std::numeric_limits<size_t>::max(), bound);
+        return c_query.dists[to];
+    }
+
+    template <typename Weight>
+    void difference_logic<Weight>::notify(const var &v) noexcept
+    {
+        if (const auto at_v = listening.find(v); at_v != listening.cend())
+            for (const auto &l : at_v->second)
+            {
+                if (!l->batched)
+                    l->dl_value_change(v);
+                else if (in_batch.insert(v).second)
+                    batch.push_back(v);
+            }
+    }
+
+    template <typename Weight>
+    void difference_logic<Weight>::notify_batched() noexcept
+    {
+        if (batch.empty())
+            return;
+        std::unordered_map<dl_value_listener<Weight> *, std::vector<var>> batches;
+        for (const auto &v : batch)
+            if (const auto at_v = listening.find(v); at_v != listening.cend())
+                for (const auto &l : at_v->second)
+                    if (l->batched)
+                        batches[l].push_back(v);
+        batch.clear();
+        in_batch.clear();
+        for (const auto &[l, vs] : batches)
+            l->dl_values_change(vs);
+    }
+
+    template <typename Weight>
+    json::json difference_logic<Weight>::to_json() const noexcept
+    {
+        json::json j_th;
+
+        json::json j_vars(json::json_type::array);
+        j_vars.get_array().reserve(n_vars);
+        for (var i = 0; i < n_vars; ++i)
+        {
+            json::json var;
+            var["name"] = std::to_string(i);
+            if (const auto c_lb = lb(i); c_lb > -inf())
+                var["lb"] = to_string(traits::to_inf_rational(c_lb));
+            if (const auto c_ub = ub(i); c_ub < inf())
+                var["ub"] = to_string(traits::to_inf_rational(c_ub));
+            j_vars.push_back(std::move(var));
+        }
+        j_th["vars"] = std::move(j_vars);
+
+        json::json j_stats = semitone::to_json(get_theory_stats());
+        j_stats["edges"] = stats.edges;
+        j_stats["cells"] = stats.cells;
+        j_th["stats"] = std::move(j_stats);
+
+        return j_th;
+    }
+
+    template class difference_logic<utils::I>;
+    template class difference_logic<int32_t>;
+    template class difference_logic<utils::inf_rational>;
+} // namespace semitone
@@ -263,7 +263,10 @@ namespace semitone
             const auto &x_i_it = std::find_if(tableau.cbegin(), tableau.cend(), [this](const auto &v)
                                               { return value(v.first) < lb(v.first) || value(v.first) > ub(v.first); });
             if (x_i_it == tableau.cend())
+            { // the theory is consistent, hence the values are final..
+                notify_batched();
                 return true;
+            }
             // the current value of the x_i variable is out of its c_bounds..
             const var x_i = (*x_i_it).first;
             // the flawed row..
@@ -273,7 +276,11 @@ namespace semitone
                 const auto &x_j_it = std::find_if(f_row->l.vars.cbegin(), f_row->l.vars.cend(), [f_row, this](const std::pair<var, utils::rational> &v)
                                                   { return (is_positive(f_row->l.vars.at(v.first)) && value(v.first) < ub(v.first)) || (is_negative(f_row->l.vars.at(v.first)) && value(v.first) > lb(v.first)); });
                 if (x_j_it != f_row->l.vars.cend()) // var x_j can be used to increase the value of x_i..
+                {
+                    if (!within_budget(1))
+                        return true; // the sat core interrupts the propagation, the pending bounds will be fixed by a subsequent check..
                     pivot_and_update(x_i, (*x_j_it).first, lb(x_i));
+                }
                 else
                 { // we generate an explanation for the conflict..
                     for (const auto &[v, c] : f_row->l.vars)
@@ -290,7 +297,11 @@ namespace semitone
                 const auto &x_j_it = std::find_if(f_row->l.vars.cbegin(), f_row->l.vars.cend(), [f_row, this](const std::pair<var, utils::rational> &v)
                                                   { return (is_negative(f_row->l.vars.at(v.first)) && value(v.first) < ub(v.first)) || (is_positive(f_row->l.vars.at(v.first)) && value(v.first) > lb(v.first)); });
                 if (x_j_it != f_row->l.vars.cend()) // var x_j can be used to decrease the value of x_i..
+                {
+                    if (!within_budget(1))
+                        return true; // the sat core interrupts the propagation, the pending bounds will be fixed by a subsequent check..
                     pivot_and_update(x_i, (*x_j_it).first, ub(x_i));
+                }
                 else
                 { // we generate an explanation for the conflict..
                     for (const auto &[v, c] : f_row->l.vars)
@@ -390,15 +401,11 @@ namespace semitone
         for (const auto &c : t_watches[x_i])
         { // x_j = x_j + a_ji(v - x_i)..
             vals[c->x] += c->l.vars.at(x_i) * (v - vals[x_i]);
-            if (const auto at_c_x = listening.find(c->x); at_c_x != listening.cend())
-                for (const auto &l : at_c_x->second)
-                    l->lra_value_change(c->x);
+            notify(c->x);
         }
         // x_i = v..
         vals[x_i] = v;
-        if (const auto at_x_i = listening.find(x_i); at_x_i != listening.cend())
-            for (const auto &l : at_x_i->second)
-                l->lra_value_change(x_i);
+        notify(x_i);
     }
 
     void lra_theory::pivot_and_update(const var &x_i, const var &x_j, const utils::inf_rational &v) noexcept
@@ -412,29 +419,51 @@ namespace semitone
 
         // x_i = v
         vals[x_i] = v;
-        if (const auto at_x_i = listening.find(x_i); at_x_i != listening.cend())
-            for (const auto &l : at_x_i->second)
-                l->lra_value_change(x_i);
+        notify(x_i);
 
         // x_j += theta
         vals[x_j] += theta;
-        if (const auto at_x_j = listening.find(x_j); at_x_j != listening.cend())
-            for (const auto &l : at_x_j->second)
-                l->lra_value_change(x_j);
+        notify(x_j);
 
         // the tableau rows containing `x_j` as a non-basic variable..
         for (const auto &c : t_watches[x_j])
             if (c->x != x_i)
             { // x_k += a_kj * theta..
                 vals[c->x] += c->l.vars.at(x_j) * theta;
-                if (const auto at_x_c = listening.find(c->x); at_x_c != listening.cend())
-                    for (const auto &l : at_x_c->second)
-                        l->lra_value_change(c->x);
+                notify(c->x);
             }
 
         pivot(x_i, x_j);
     }
 
+    void lra_theory::notify(const var &x) noexcept
+    {
+        if (const auto at_x = listening.find(x); at_x != listening.cend())
+            for (const auto &l : at_x->second)
+            {
+                if (!l->batched)
+                    l->lra_value_change(x);
+                else if (in_batch.insert(x).second)
+                    batch.push_back(x);
+            }
+    }
+
+    void lra_theory::notify_batched() noexcept
+    {
+        if (batch.empty())
+            return;
+        std::unordered_map<lra_value_listener *, std::vector<var>> batches;
+        for (const auto &x : batch)
+            if (const auto at_x = listening.find(x); at_x != listening.cend())
+                for (const auto &l : at_x->second)
+                    if (l->batched)
+                        batches[l].push_back(x);
+        batch.clear();
+        in_batch.clear();
+        for (const auto &[l, xs] : batches)
+            l->lra_values_change(xs);
+    }
+
     void lra_theory::pivot(const var x_i, const var x_j) noexcept
     {
         // the exiting row..
@@ -454,6 +483,8 @@ namespace semitone
         // these are the rows in which x_j appears..
         std::unordered_set<row *> x_j_watches;
         std::swap(x_j_watches, t_watches[x_j]);
+        SEMITONE_STATS(++stats.pivots);
+        SEMITONE_STATS(stats.row_updates += x_j_watches.size());
         for (const auto &r : x_j_watches)
         { // `r` is a row in which `x_j` appears..
             utils::rational cc = r->l.vars[x_j];
@@ -519,6 +550,11 @@ namespace semitone
             j_tabl.push_back(to_json(*it->second));
         j_th["tableau"] = std::move(j_tabl);
 
+        json::json j_stats = to_json(rhs.get_theory_stats());
+        j_stats["pivots"] = rhs.stats.pivots;
+        j_stats["row_updates"] = rhs.stats.row_updates;
+        j_th["stats"] = std::move(j_stats);
+
         return j_th;
     }
 } // namespace semitone
\ No newline at end of file
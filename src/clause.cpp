@@ -14,6 +14,8 @@ namespace semitone
     }
     clause::~clause()
     {
+        if (is_detached())
+            return; // the sat core has already cleaned up the watch lists and the reasons..
         auto &l0_w = watches(!lits[0]);
         l0_w.erase(std::find(l0_w.cbegin(), l0_w.cend(), this));
         auto &l1_w = watches(!lits[1]);
@@ -51,16 +53,14 @@ namespace semitone
 
     bool clause::simplify() noexcept
     {
+        // the watched literals must be preserved for detaching a satisfied clause..
+        if (std::any_of(lits.cbegin(), lits.cend(), [this](const auto &l)
+                        { return value(l) == utils::True; }))
+            return true;
         size_t j = 0;
         for (size_t i = 0; i < lits.size(); ++i)
-            switch (value(lits[i]))
-            {
-            case utils::True:
-                return true;
-            case utils::Undefined:
+            if (value(lits[i]) == utils::Undefined)
                 lits[j++] = lits[i];
-                break;
-            }
         lits.resize(j);
         return false;
     }
@@ -76,6 +76,12 @@ namespace semitone
         }
     }
 
+    void clause::get_watched(std::vector<lit> &out_watched) const noexcept
+    {
+        out_watched.push_back(!lits[0]);
+        out_watched.push_back(!lits[1]);
+    }
+
     json::json clause::to_json() const noexcept
     {
         json::json j_cl;
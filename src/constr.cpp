@@ -8,8 +8,8 @@ namespace semitone
     std::vector<constr *> &constr::watches(const lit &p) noexcept { return sat.watches[index(p)]; }
     bool constr::enqueue(const lit &p) noexcept { return sat.enqueue(p, this); }
 
-    utils::lbool constr::value(const var &x) const noexcept { return sat.value(x); }
-    utils::lbool constr::value(const lit &p) const noexcept { return sat.value(p); }
+    utils::lbool constr::value(const var &x) const noexcept { return sat.assigns[x]; }
+    utils::lbool constr::value(const lit &p) const noexcept { return sat.assigned(p); }
 
     void constr::remove_constr_from_reason(const var &x) noexcept
     {
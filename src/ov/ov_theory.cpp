@@ -1,61 +1,62 @@
 #include "ov_theory.h"
 #include "ov_value_listener.h"
 #include <algorithm>
+#include <array>
 #include <cassert>
+#include <limits>
 
 namespace semitone
 {
-    SEMITONE_EXPORT ov_theory::ov_theory(sat_ptr sat) : theory(std::move(sat)) {}
+    SEMITONE_EXPORT ov_theory::ov_theory(sat_ptr sat) : theory(std::move(sat)), doms(1, 0) {}
 
     SEMITONE_EXPORT var ov_theory::new_var(const std::vector<utils::enum_val *> &items, const bool enforce_exct_one) noexcept
     {
         assert(!items.empty());
-        const var id = assigns.size();
-        auto c_vals = std::unordered_map<utils::enum_val *, lit>();
+        const var id = doms.size() - 1;
+        std::vector<std::pair<size_t, lit>> c_dom;
+        c_dom.reserve(items.size());
         if (items.size() == 1)
-            c_vals.emplace(*items.cbegin(), TRUE_lit);
+            c_dom.emplace_back(value_id(**items.cbegin()), TRUE_lit);
         else
         {
+            std::vector<lit> lits;
+            lits.reserve(items.size());
             for (const auto &i : items)
             {
                 const var bv = sat->new_var();
-                c_vals.emplace(i, lit(bv));
+                c_dom.emplace_back(value_id(*i), lit(bv));
+                lits.push_back(lit(bv));
                 bind(bv);
                 is_contained_in[bv].insert(id);
             }
             if (enforce_exct_one)
             {
-                std::vector<lit> lits;
-                lits.reserve(items.size());
-                for (const auto &i : items)
-                    lits.push_back(c_vals.find(i)->second);
                 [[maybe_unused]] bool exct_one = sat->new_clause({sat->new_exct_one(std::move(lits))});
                 assert(exct_one);
             }
         }
-        assigns.push_back(c_vals);
-        return id;
+        return new_domain(std::move(c_dom));
     }
 
     SEMITONE_EXPORT var ov_theory::new_var(const std::vector<lit> &lits, const std::vector<utils::enum_val *> &vals) noexcept
     {
         assert(!lits.empty());
         assert(lits.size() == vals.size());
-        const var id = assigns.size();
-        auto c_vals = std::unordered_map<utils::enum_val *, lit>();
+        const var id = doms.size() - 1;
+        std::vector<std::pair<size_t, lit>> c_dom;
+        c_dom.reserve(lits.size());
         for (size_t i = 0; i < lits.size(); ++i)
         {
-            c_vals.emplace(vals[i], lits[i]);
+            c_dom.emplace_back(value_id(*vals[i]), lits[i]);
             is_contained_in[variable(lits[i])].insert(id);
         }
-        assigns.push_back(c_vals);
-        return id;
+        return new_domain(std::move(c_dom));
     }
 
     SEMITONE_EXPORT lit ov_theory::allows(const var &v, utils::enum_val &val) const noexcept
     {
-        if (auto at_right = assigns[v].find(&val); at_right != assigns[v].cend())
-            return at_right->second;
+        if (const auto pos = find(v, val); pos != doms[v + 1])
+            return dom_lits[pos];
         else
             return FALSE_lit;
     }
@@ -73,63 +74,518 @@ namespace semitone
             return at_expr->second;
         else
         {
-            std::unordered_set<utils::enum_val *> intersection;
-            for ([[maybe_unused]] const auto &[val, l] : assigns[left])
-                if (assigns[right].count(val))
-                    intersection.insert(val);
+            // the domains are sorted by value id, hence we check whether they intersect by merging..
+            bool intersect = false;
+            for (size_t l = doms[left], r = doms[right]; !intersect && l < doms[left + 1] && r < doms[right + 1];)
+                if (dom_vals[l] < dom_vals[r])
+                    ++l;
+                else if (dom_vals[r] < dom_vals[l])
+                    ++r;
+                else
+                    intersect = true;
 
-            if (intersection.empty())
+            if (!intersect)
                 return FALSE_lit;
 
-            // we need to create a new variable..
+            if (sat->root_level())
+            { // the root-level assignments might already decide the equality, while the ones within the search are retracted on backtracking, hence they cannot be cached..
+                bool must_hold = false, cant_hold = false;
+                for_each_value(left, right, [this, &must_hold, &cant_hold](const lit &l, const lit &r)
+                               {
+                                   if (sat->value(l) != utils::Undefined && sat->value(r) != utils::Undefined)
+                                   {
+                                       if (sat->value(l) != sat->value(r))
+                                           cant_hold = true; // the value is allowed in one domain only..
+                                       else if (sat->value(l) == utils::True)
+                                           must_hold = true; // the value is the same in both domains..
+                                   }
+                                   return true; });
+                if (cant_hold || must_hold)
+                {
+                    exprs.emplace(s_expr, cant_hold ? FALSE_lit : TRUE_lit);
+                    return cant_hold ? FALSE_lit : TRUE_lit;
+                }
+            }
+
+            // we need to create a new variable, whose consequences are propagated by the theory..
             const lit eq_lit = lit(sat->new_var()); // the equality literal..
+            bind(variable(eq_lit));
+            for (const auto &v : {left, right})
+                for (size_t pos = doms[v]; pos < doms[v + 1]; ++pos)
+                    if (variable(dom_lits[pos]) != FALSE_var)
+                        bind(variable(dom_lits[pos]));
+            eq_ids.emplace(variable(eq_lit), eqs.size());
+            var_eqs[left].push_back(eqs.size());
+            var_eqs[right].push_back(eqs.size());
+            eqs.push_back({eq_lit, left, right});
+
+            if (!sat->root_level())
+            { // the current assignments might already decide the equality, hence we enqueue the equality literal, explained by the first deciding value..
+                bool decided = false;
+                for_each_value(left, right, [this, &eq_lit, &decided](const lit &l, const lit &r)
+                               {
+                                   if (sat->value(l) == utils::Undefined || sat->value(r) == utils::Undefined || (sat->value(l) == utils::False && sat->value(r) == utils::False))
+                                       return true; // the value does not decide the equality..
+                                   decided = true;
+                                   [[maybe_unused]] const bool prop = propagate_eq(eq_lit, l, r);
+                                   assert(prop);
+                                   return false; });
+                if (decided)
+                    sat->propagate();
+            }
+
+            exprs.emplace(s_expr, eq_lit);
+            return eq_lit;
+        }
+    }
+
+    SEMITONE_EXPORT bool ov_theory::new_all_different(const std::vector<var> &vars) noexcept
+    {
+        assert(sat->root_level());
+        assert(std::all_of(vars.cbegin(), vars.cend(), [&vars](const var &v)
+                           { return std::count(vars.cbegin(), vars.cend(), v) == 1; })); // the variables are distinct..
+        // we index the values of the union of the domains..
+        std::vector<size_t> c_vals;
+        for (const auto &v : vars)
+            c_vals.insert(c_vals.cend(), dom_vals.cbegin() + doms[v], dom_vals.cbegin() + doms[v + 1]);
+        std::sort(c_vals.begin(), c_vals.end());
+        c_vals.erase(std::unique(c_vals.begin(), c_vals.end()), c_vals.end());
+
+        const size_t ad_id = all_diffs.size();
+        ov_all_different ad;
+        ad.vars = vars;
+        ad.edges.resize(vars.size());
+        for (size_t i = 0; i < vars.size(); ++i)
+        {
+            for (size_t pos = doms[vars[i]]; pos < doms[vars[i] + 1]; ++pos)
+            {
+                ad.edges[i].emplace_back(pos, std::lower_bound(c_vals.cbegin(), c_vals.cend(), dom_vals[pos]) - c_vals.cbegin());
+                if (variable(dom_lits[pos]) != FALSE_var)
+                    bind(variable(dom_lits[pos]));
+            }
+            var_all_diffs[vars[i]].push_back(ad_id);
+        }
+        ad.n_vals = c_vals.size();
+        ad.var_match.assign(vars.size(), std::numeric_limits<size_t>::max());
+        ad.val_match.assign(ad.n_vals, std::numeric_limits<size_t>::max());
+        ad.var_seen.assign(vars.size(), 0);
+        ad.val_seen.assign(ad.n_vals, 0);
+        all_diffs.push_back(std::move(ad));
+
+        if (!propagate_all_different(ad_id))
+        { // the constraint cannot be satisfied..
+            cnfl.clear();
+            return false;
+        }
+        return sat->propagate();
+    }
+
+    SEMITONE_EXPORT std::unordered_set<utils::enum_val *> ov_theory::value(var v) const noexcept
+    {
+        std::unordered_set<utils::enum_val *> c_vals;
+        for (const auto &val : domain(v))
+            c_vals.insert(val);
+        return c_vals;
+    }
+
+    SEMITONE_EXPORT size_t ov_theory::domain_size(const var &v) const noexcept
+    {
+        const auto dom = domain(v);
+        return std::distance(dom.begin(), dom.end());
+    }
+
+    SEMITONE_EXPORT bool ov_theory::contains(const var &v, const utils::enum_val &val) const noexcept
+    {
+        const auto pos = find(v, val);
+        return pos != doms[v + 1] && sat->value(dom_lits[pos]) != utils::False;
+    }
+
+    SEMITONE_EXPORT void ov_theory::listen(const var &v, ov_value_listener *const l) noexcept
+    {
+        if (domain_size(v) > 1)
+        {
+            const auto dom = domain(v);
+            for (auto it = dom.begin(); it != dom.end(); ++it)
+                l->listen_sat(variable(it.allows()));
+            // we take a snapshot of the domain, against which the subsequent changes are computed..
+            auto &c_alive = l->snapshots[v].alive;
+            c_alive.clear();
+            for (size_t pos = doms[v]; pos < doms[v + 1]; ++pos)
+                c_alive.push_back(sat->value(dom_lits[pos]) != utils::False);
+        }
+    }
+
+    void ov_theory::notify_listeners() noexcept
+    {
+        for (const auto &l : listeners)
+        {
+            for (const auto &v : l->dirty)
+            {
+                auto &[c_alive, c_dirty] = l->snapshots.at(v);
+                c_dirty = false;
+                ov_value_listener::ov_delta delta;
+                size_t n_vals = 0;
+                utils::enum_val *c_val = nullptr;
+                for (size_t pos = doms[v]; pos < doms[v + 1]; ++pos)
+                {
+                    const bool is_alive = sat->value(dom_lits[pos]) != utils::False;
+                    if (is_alive)
+                    {
+                        ++n_vals;
+                        c_val = vals[dom_vals[pos]];
+                    }
+                    if (is_alive != c_alive[pos - doms[v]])
+                    {
+                        (is_alive ? delta.restored : delta.removed).push_back(vals[dom_vals[pos]]);
+                        c_alive[pos - doms[v]] = is_alive;
+                    }
+                }
+                if (delta.removed.empty() && delta.restored.empty())
+                    continue; // the changes have been undone within the same round..
+                if (n_vals == 1 && !delta.removed.empty())
+                    delta.fixed = c_val; // the domain has just become a singleton..
+                l->ov_domain_change(v, delta);
+            }
+            l->dirty.clear();
+        }
+    }
+
+    bool ov_theory::propagate(const lit &p) noexcept
+    {
+        assert(cnfl.empty());
+        if (const auto at_eq = eq_ids.find(variable(p)); at_eq != eq_ids.cend())
+            if (!propagate_eq(at_eq->second))
+                return false;
+
+        if (const auto at_pos = var_pos.find(variable(p)); at_pos != var_pos.cend())
+            for (const auto &pos : at_pos->second)
+            { // we propagate the equality constraints involving the object variable whose domain contains `p`..
+                const var x = owner(pos);
+                for (const auto &eq_id : var_eqs[x])
+                {
+                    const auto &c_eq = eqs[eq_id];
+                    const var y = c_eq.left == x ? c_eq.right : c_eq.left;
+                    const auto y_pos = find(y, dom_vals[pos]);
+                    if (!propagate_eq(c_eq.eq, dom_lits[pos], y_pos != doms[y + 1] ? dom_lits[y_pos] : FALSE_lit))
+                        return false;
+                }
+                // the all-different constraints involving the object variable are propagated when checking..
+                for (const auto &ad_id : var_all_diffs[x])
+                    if (!all_diffs[ad_id].dirty)
+                    {
+                        all_diffs[ad_id].dirty = true;
+                        dirty_all_diffs.push_back(ad_id);
+                    }
+            }
+        return true;
+    }
+
+    bool ov_theory::check() noexcept
+    {
+        assert(cnfl.empty());
+        while (!dirty_all_diffs.empty())
+        {
+            const size_t ad_id = dirty_all_diffs.back();
+            dirty_all_diffs.pop_back();
+            all_diffs[ad_id].dirty = false;
+            if (!propagate_all_different(ad_id))
+                return false; // the remaining constraints are propagated after backjumping..
+        }
+        notify_listeners();
+        return true;
+    }
+
+    void ov_theory::pop() noexcept
+    {
+        if (!is_propagating()) // while backjumping, the domain changes of the popped levels are delivered at once, at the next check..
+            notify_listeners();
+    }
+
+    bool ov_theory::propagate_eq(const size_t &eq_id) noexcept
+    {
+        const auto &c_eq = eqs[eq_id];
+        return for_each_value(c_eq.left, c_eq.right, [this, &c_eq](const lit &l, const lit &r)
+                              { return propagate_eq(c_eq.eq, l, r); });
+    }
+
+    bool ov_theory::propagate_eq(const lit &eq, const lit &left, const lit &right) noexcept
+    {
+        for (const auto &cls : {std::array<lit, 3>{!eq, !left, right}, std::array<lit, 3>{!eq, left, !right}, std::array<lit, 3>{eq, !left, !right}})
+        {
+            if (std::any_of(cls.cbegin(), cls.cend(), [this](const auto &l)
+                            { return sat->value(l) == utils::True; }))
+                continue; // the clause is satisfied..
+            const auto n_undef = std::count_if(cls.cbegin(), cls.cend(), [this](const auto &l)
+                                               { return sat->value(l) == utils::Undefined; });
+            if (n_undef > 1)
+                continue; // the clause is not unit yet..
+
+            // we build the clause, with the unassigned literal (if any) in front, and without the constant literals..
+            std::vector<lit> c_cls;
+            for (const auto &l : cls)
+                if (sat->value(l) == utils::Undefined)
+                    c_cls.insert(c_cls.cbegin(), l);
+                else if (variable(l) != FALSE_var)
+                    c_cls.push_back(l);
+            if (n_undef == 0)
+            { // the clause is violated..
+                cnfl = std::move(c_cls);
+                return false;
+            }
+            // we propagate the unassigned literal..
+            record(std::move(c_cls));
+        }
+        return true;
+    }
+
+    bool ov_theory::propagate_all_different(const size_t &ad_id) noexcept
+    {
+        constexpr size_t npos = std::numeric_limits<size_t>::max();
+        auto &ad = all_diffs[ad_id];
+        const size_t n_vars = ad.vars.size();
+        const auto is_alive = [this](const size_t &pos)
+        { return sat->value(dom_lits[pos]) != utils::False; };
+
+        // we drop the matched edges whose values have been removed..
+        for (size_t i = 0; i < n_vars; ++i)
+            if (ad.var_match[i] != npos && !is_alive(ad.edges[i][ad.var_match[i]].first))
+            {
+                ad.val_match[ad.edges[i][ad.var_match[i]].second] = npos;
+                ad.var_match[i] = npos;
+            }
+
+        // we repair the matching, looking for augmenting paths from the unmatched variables..
+        for (size_t i = 0; i < n_vars; ++i)
+            if (ad.var_match[i] == npos)
+            {
+                ++ad.stamp;
+                if (!augment(ad, i))
+                { // the visited variables can take less values than their number (Hall's theorem), hence some of the removed values must be restored..
+                    for (size_t j = 0; j < n_vars; ++j)
+                        if (ad.var_seen[j] == ad.stamp)
+                            for (const auto &[pos, w] : ad.edges[j])
+                                if (!is_alive(pos) && ad.val_seen[w] != ad.stamp && variable(dom_lits[pos]) != FALSE_var)
+                                    cnfl.push_back(dom_lits[pos]);
+                    assert(!cnfl.empty() || sat->root_level());
+                    return false;
+                }
+            }
 
-            [[maybe_unused]] bool nc;
-            // the values outside the intersection are pruned if the equality control variable becomes true..
-            for (const auto &[val, l] : assigns[left])
-                if (!intersection.count(val))
+        // we build the residual graph, whose nodes are the variables followed by the values, orienting the matched edges from the values to the variables..
+        const size_t n_nodes = n_vars + ad.n_vals;
+        std::vector<std::vector<size_t>> out(n_nodes), in(n_nodes);
+        std::vector<bool> used(ad.n_vals, false);
+        for (size_t i = 0; i < n_vars; ++i)
+            for (size_t k = 0; k < ad.edges[i].size(); ++k)
+                if (const auto &[pos, w] = ad.edges[i][k]; is_alive(pos))
                 {
-                    nc = sat->new_clause({!eq_lit, !l});
-                    assert(nc);
+                    used[w] = true;
+                    if (k == ad.var_match[i])
+                    {
+                        out[n_vars + w].push_back(i);
+                        in[i].push_back(n_vars + w);
+                    }
+                    else
+                    {
+                        out[i].push_back(n_vars + w);
+                        in[n_vars + w].push_back(i);
+                    }
                 }
-            for (const auto &[val, l] : assigns[right])
-                if (!intersection.count(val))
+
+        // the edges lying on an alternating path which ends in a free value belong to some maximum matching..
+        std::vector<bool> to_free(n_nodes, false);
+        std::vector<size_t> q;
+        for (size_t w = 0; w < ad.n_vals; ++w)
+            if (used[w] && ad.val_match[w] == npos)
+            {
+                to_free[n_vars + w] = true;
+                q.push_back(n_vars + w);
+            }
+        while (!q.empty())
+        {
+            const size_t n = q.back();
+            q.pop_back();
+            for (const auto &m : in[n])
+                if (!to_free[m])
                 {
-                    nc = sat->new_clause({!eq_lit, !l});
-                    assert(nc);
+                    to_free[m] = true;
+                    q.push_back(m);
                 }
-            // the values inside the intersection are made pairwise equal if the equality variable becomes true..
-            for (const auto &v : intersection)
+        }
+
+        // ..and so do the edges lying on an alternating cycle, i.e., connecting nodes of the same strongly connected component (Tarjan)..
+        std::vector<size_t> idx(n_nodes, npos), low(n_nodes, 0), scc(n_nodes, npos), stack;
+        std::vector<std::pair<size_t, size_t>> calls;
+        size_t c_idx = 0;
+        for (size_t root = 0; root < n_nodes; ++root)
+            if (idx[root] == npos)
             {
-                nc = sat->new_clause({!eq_lit, !assigns[left].at(v), assigns[right].at(v)});
-                assert(nc);
-                nc = sat->new_clause({!eq_lit, assigns[left].at(v), !assigns[right].at(v)});
-                assert(nc);
-                nc = sat->new_clause({eq_lit, !assigns[left].at(v), !assigns[right].at(v)});
-                assert(nc);
+                calls.emplace_back(root, 0);
+                idx[root] = low[root] = c_idx++;
+                stack.push_back(root);
+                while (!calls.empty())
+                {
+                    auto &[n, e] = calls.back();
+                    if (e < out[n].size())
+                    {
+                        const size_t m = out[n][e++];
+                        if (idx[m] == npos)
+                        {
+                            idx[m] = low[m] = c_idx++;
+                            stack.push_back(m);
+                            calls.emplace_back(m, 0);
+                        }
+                        else if (scc[m] == npos)
+                            low[n] = std::min(low[n], idx[m]);
+                    }
+                    else
+                    {
+                        const size_t c_n = n;
+                        calls.pop_back();
+                        if (!calls.empty())
+                            low[calls.back().first] = std::min(low[calls.back().first], low[c_n]);
+                        if (low[c_n] == idx[c_n])
+                        { // `c_n` is the root of a strongly connected component..
+                            size_t m;
+                            do
+                            {
+                                m = stack.back();
+                                stack.pop_back();
+                                scc[m] = c_n;
+                            } while (m != c_n);
+                        }
+                    }
+                }
             }
 
-            exprs.emplace(s_expr, eq_lit);
-            return eq_lit;
+        // we remove the remaining unmatched edges, explaining each removal through the values which are missing to the variables reachable from the removed value..
+        std::vector<std::vector<lit>> expls(ad.n_vals);
+        std::vector<bool> c_expl(ad.n_vals, false);
+        std::vector<bool> reached(n_nodes, false);
+        for (size_t i = 0; i < n_vars; ++i)
+            for (size_t k = 0; k < ad.edges[i].size(); ++k)
+            {
+                const auto &[pos, w] = ad.edges[i][k];
+                if (k == ad.var_match[i] || !is_alive(pos) || to_free[n_vars + w] || scc[i] == scc[n_vars + w])
+                    continue; // the value is still supported..
+                if (!c_expl[w])
+                { // the variables reachable from `w` are bound to take the values reachable from `w`..
+                    c_expl[w] = true;
+                    std::fill(reached.begin(), reached.end(), false);
+                    reached[n_vars + w] = true;
+                    q.push_back(n_vars + w);
+                    while (!q.empty())
+                    {
+                        const size_t n = q.back();
+                        q.pop_back();
+                        for (const auto &m : out[n])
+                            if (!reached[m])
+                            {
+                                reached[m] = true;
+                                q.push_back(m);
+                            }
+                    }
+                    for (size_t j = 0; j < n_vars; ++j)
+                        if (reached[j])
+                            for (const auto &[c_pos, u] : ad.edges[j])
+                                if (!reached[n_vars + u] && !is_alive(c_pos) && variable(dom_lits[c_pos]) != FALSE_var)
+                                    expls[w].push_back(dom_lits[c_pos]);
+                }
+
+                std::vector<lit> c_cls;
+                c_cls.reserve(expls[w].size() + 1);
+                c_cls.push_back(!dom_lits[pos]);
+                c_cls.insert(c_cls.cend(), expls[w].cbegin(), expls[w].cend());
+                if (sat->value(dom_lits[pos]) == utils::True)
+                { // the value has been assigned to the variable..
+                    cnfl = std::move(c_cls);
+                    return false;
+                }
+                record(std::move(c_cls));
+            }
+        return true;
+    }
+
+    bool ov_theory::augment(ov_all_different &ad, const size_t &i) noexcept
+    {
+        ad.var_seen[i] = ad.stamp;
+        for (size_t k = 0; k < ad.edges[i].size(); ++k)
+        {
+            const auto &[pos, w] = ad.edges[i][k];
+            if (ad.val_seen[w] == ad.stamp || sat->value(dom_lits[pos]) == utils::False)
+                continue;
+            ad.val_seen[w] = ad.stamp;
+            if (ad.val_match[w] == std::numeric_limits<size_t>::max() || augment(ad, ad.val_match[w]))
+            {
+                ad.var_match[i] = k;
+                ad.val_match[w] = i;
+                return true;
+            }
         }
+        return false;
     }
 
-    SEMITONE_EXPORT std::unordered_set<utils::enum_val *> ov_theory::value(var v) const noexcept
+    template <typename F>
+    bool ov_theory::for_each_value(const var &left, const var &right, F f) const
     {
-        std::unordered_set<utils::enum_val *> vals;
-        for (const auto &[val, l] : assigns[v])
-            if (sat->value(l) != utils::False)
-                vals.insert(val);
-        return vals;
+        size_t l = doms[left], r = doms[right];
+        while (l < doms[left + 1] || r < doms[right + 1])
+            if (r == doms[right + 1] || (l < doms[left + 1] && dom_vals[l] < dom_vals[r]))
+            { // the value is in the domain of `left` only..
+                if (!f(dom_lits[l++], FALSE_lit))
+                    return false;
+            }
+            else if (l == doms[left + 1] || dom_vals[r] < dom_vals[l])
+            { // the value is in the domain of `right` only..
+                if (!f(FALSE_lit, dom_lits[r++]))
+                    return false;
+            }
+            else if (!f(dom_lits[l++], dom_lits[r++]))
+                return false;
+        return true;
     }
 
-    SEMITONE_EXPORT void ov_theory::listen(const var &v, ov_value_listener *const l) noexcept
+    var ov_theory::new_domain(std::vector<std::pair<size_t, lit>> dom) noexcept
     {
-        auto domain = value(v);
-        if (domain.size() > 1)
+        const var id = doms.size() - 1;
+        std::sort(dom.begin(), dom.end(), [](const auto &lhs, const auto &rhs)
+                  { return lhs.first < rhs.first; });
+        assert(std::adjacent_find(dom.cbegin(), dom.cend(), [](const auto &lhs, const auto &rhs)
+                                  { return lhs.first == rhs.first; }) == dom.cend()); // the values of a domain are distinct..
+        for (const auto &[val_id, l] : dom)
         {
-            for (const auto &val : domain)
-                l->listen_sat(variable(assigns[v].at(val)));
+            dom_vals.push_back(val_id);
+            dom_lits.push_back(l);
         }
+        doms.push_back(dom_vals.size());
+        var_eqs.emplace_back();
+        var_all_diffs.emplace_back();
+        for (size_t pos = doms[id]; pos < doms[id + 1]; ++pos)
+            if (variable(dom_lits[pos]) != FALSE_var)
+                var_pos[variable(dom_lits[pos])].push_back(pos);
+        return id;
+    }
+
+    size_t ov_theory::value_id(utils::enum_val &val) noexcept
+    {
+        const auto [at_val, inserted] = val_ids.emplace(&val, vals.size());
+        if (inserted)
+            vals.push_back(&val);
+        return at_val->second;
     }
-} // namespace semitone
\ No newline at end of file
+
+    size_t ov_theory::find(const var &v, const utils::enum_val &val) const noexcept
+    {
+        const auto at_val = val_ids.find(&val);
+        return at_val != val_ids.cend() ? find(v, at_val->second) : doms[v + 1]; // the value might have never been indexed..
+    }
+
+    size_t ov_theory::find(const var &v, const size_t &val_id) const noexcept
+    {
+        const auto first = dom_vals.cbegin() + doms[v], last = dom_vals.cbegin() + doms[v + 1];
+        const auto it = std::lower_bound(first, last, val_id);
+        return it != last && *it == val_id ? static_cast<size_t>(it - dom_vals.cbegin()) : doms[v + 1];
+    }
+
+    var ov_theory::owner(const size_t &pos) const noexcept { return std::upper_bound(doms.cbegin(), doms.cend(), pos) - doms.cbegin() - 1; }
+} // namespace semitone
@@ -4,10 +4,29 @@
 #include "theory.h"
 #include <algorithm>
 #include <cmath>
+#include <limits>
 #include <cassert>
 
 namespace semitone
 {
+    /**
+     * Invokes `f`, counting the call and adding the elapsed time to `time`, unless the statistics are removed at compile time.
+     */
+    template <typename F>
+    static auto timed([[maybe_unused]] size_t &calls, [[maybe_unused]] std::chrono::steady_clock::duration &time, F &&f)
+    {
+#ifndef NO_STATISTICS
+        struct timer
+        {
+            std::chrono::steady_clock::duration &time;
+            const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            ~timer() { time += std::chrono::steady_clock::now() - start; }
+        } t{time};
+        ++calls;
+#endif
+        return f();
+    }
+
     SEMITONE_EXPORT sat_core::sat_core()
     {
         [[maybe_unused]] var c_false = new_var(); // the false constant..
@@ -15,7 +34,7 @@ namespace semitone
         assigns[FALSE_var] = utils::False;
         level[FALSE_var] = 0;
     }
-    SEMITONE_EXPORT sat_core::sat_core(const sat_core &orig) : countable(), assigns(orig.assigns), level(orig.level.size()), exprs(orig.exprs), theories(orig.theories), bounds(orig.bounds), listeners(orig.listeners), listening(orig.listening)
+    SEMITONE_EXPORT sat_core::sat_core(const sat_core &orig) : countable(), assigns(orig.assigns), level(orig.level.size()), exprs(orig.exprs), frozen(orig.frozen), eliminated(orig.eliminated), elim_stack(orig.elim_stack), substs(orig.substs), theories(orig.theories), bounds(orig.bounds), listeners(orig.listeners), listening(orig.listening), chrono_threshold(orig.chrono_threshold), budget(orig.budget), n_conflicts(orig.n_conflicts), n_propagations(orig.n_propagations), n_pivots(orig.n_pivots)
     {
         assert(orig.prop_q.empty());
         constrs.reserve(orig.constrs.size());
@@ -48,12 +67,18 @@ namespace semitone
         exprs.emplace("b" + std::to_string(id), id);
         level.emplace_back(0);
         reason.emplace_back(nullptr);
+        frozen.push_back(false);
+        eliminated.push_back(false);
+        substs.emplace_back();
+        if (!lookaheads.empty()) // the new variable might be constrained, hence the cached lookaheads might miss some consequences..
+            lookaheads.clear();
         return id;
     }
 
     SEMITONE_EXPORT bool sat_core::new_clause(std::vector<lit> lits) noexcept
     {
         assert(root_level());
+        to_representatives(lits);
         // we check if the clause is already satisfied and filter out false/duplicate literals..
         std::sort(lits.begin(), lits.end(), [](const auto &l0, const auto &l1)
                   { return variable(l0) < variable(l1); });
@@ -75,15 +100,18 @@ namespace semitone
             return false;
         case 1: // the clause is unique under the current assignment..
             return enqueue(lits[0]);
-        default: // we need to create a new clause..
+        default: // we need to create a new clause, whose consequences might be missed by the cached lookaheads..
+            lookaheads.clear();
             constrs.push_back(new clause(*this, std::move(lits)));
             return true;
         }
     }
 
-    lit sat_core::new_eq(const lit &left, const lit &right) noexcept
+    lit sat_core::new_eq(const lit &l, const lit &r) noexcept
     {
         assert(root_level());
+        const lit left = representative(l), right = representative(r);
+        assert(!eliminated[variable(left)] && !eliminated[variable(right)]);
         // we try to avoid creating a new variable..
         if (left == right)
             return TRUE_lit; // the variables are the same variable..
@@ -143,6 +171,7 @@ namespace semitone
     SEMITONE_EXPORT lit sat_core::new_conj(std::vector<lit> ls) noexcept
     {
         assert(root_level());
+        to_representatives(ls);
         // we try to avoid creating a new variable..
         std::sort(ls.begin(), ls.end(), [](const auto &l0, const auto &l1)
                   { return variable(l0) < variable(l1); });
@@ -188,6 +217,7 @@ namespace semitone
     SEMITONE_EXPORT lit sat_core::new_disj(std::vector<lit> ls) noexcept
     {
         assert(root_level());
+        to_representatives(ls);
         // we try to avoid creating a new variable..
         std::sort(ls.begin(), ls.end(), [](const auto &l0, const auto &l1)
                   { return variable(l0) < variable(l1); });
@@ -233,6 +263,7 @@ namespace semitone
     SEMITONE_EXPORT lit sat_core::new_at_most_one(std::vector<lit> ls) noexcept
     {
         assert(root_level());
+        to_representatives(ls);
         // we try to avoid creating a new variable..
         std::sort(ls.begin(), ls.end(), [](const auto &l0, const auto &l1)
                   { return variable(l0) < variable(l1); });
@@ -307,6 +338,7 @@ namespace semitone
     SEMITONE_EXPORT lit sat_core::new_exct_one(std::vector<lit> ls) noexcept
     {
         assert(root_level());
+        to_representatives(ls);
         // we try to avoid creating a new variable..
         std::sort(ls.begin(), ls.end(), [](const auto &l0, const auto &l1)
                   { return variable(l0) < variable(l1); });
@@ -356,13 +388,17 @@ namespace semitone
 
     SEMITONE_EXPORT bool sat_core::assume(const lit &p) noexcept
     {
-        LOG("+[" << to_string(p) << "]");
+        const lit q = representative(p); // the substituted literals are assumed through their representatives..
+        LOG("+[" << to_string(q) << "]");
         assert(prop_q.empty());
+        assert(!eliminated[variable(q)]);
         trail_lim.push_back(trail.size());
-        decisions.push_back(p);
+        decisions.push_back(q);
+        SEMITONE_STATS(++stats.decisions);
         for (const auto &th : theories)
-            th->push();
-        return enqueue(p) && propagate();
+            timed(th->th_stats.pushes, th->th_stats.push_time, [&th]
+                  { th->push(); });
+        return enqueue(q) && propagate();
     }
 
     SEMITONE_EXPORT void sat_core::pop() noexcept
@@ -372,9 +408,28 @@ namespace semitone
             pop_one();
         trail_lim.pop_back();
         decisions.pop_back();
+        while (!prop_q.empty()) // the literals of an interrupted propagation..
+            prop_q.pop();
 
         for (const auto &th : theories)
-            th->pop();
+            timed(th->th_stats.pops, th->th_stats.pop_time, [&th]
+                  { th->pop(); });
+
+        // the implications whose level has been retracted are forgotten, while the remaining ones are re-enqueued, once the learnt clause is recorded if backjumping..
+        missed.erase(std::remove_if(missed.begin(), missed.end(), [this](const auto &m)
+                                    { return std::get<2>(m) > decision_level(); }),
+                     missed.end());
+        if (!propagating)
+        {
+            if (requeue())
+            { // we propagate the re-enqueued literals, preserving a previous interruption..
+                const bool was_interrupted = interrupted;
+                propagate();
+                interrupted = interrupted || was_interrupted;
+            }
+            else
+                notify_listeners();
+        }
     }
 
     SEMITONE_EXPORT bool sat_core::simplify_db() noexcept
@@ -383,27 +438,501 @@ namespace semitone
         if (!propagate())
             return false;
 
-        size_t i = 0, j = constrs.size();
-        while (i < j)
-            if (constrs[i]->simplify())
-                constrs[i].swap(constrs[--j]);
+        bool detached = false;
+        for (auto &c : constrs)
+            if (c->simplify())
+            { // we mark the constraint as detached..
+                c->detached = true;
+                detached = true;
+            }
+        if (detached)
+            remove_detached();
+        return true;
+    }
+
+    SEMITONE_EXPORT bool sat_core::subsume(const size_t &budget) noexcept
+    {
+        assert(root_level());
+        if (!simplify_db())
+            return false;
+
+        // we collect the clauses, with their literals sorted by variable, along with their signatures and the occurrence lists of the literals..
+        std::vector<constr *> c_constrs;
+        std::vector<std::vector<lit>> cls;
+        std::vector<uint64_t> sigs;
+        std::vector<std::vector<size_t>> occs(watches.size());
+        const auto signature = [](const std::vector<lit> &ls)
+        {
+            uint64_t sig = 0;
+            for (const auto &l : ls)
+                sig |= uint64_t(1) << (variable(l) & 63);
+            return sig;
+        };
+        for (auto &c : constrs)
+            if (const auto ls = c->get_clause())
+            {
+                c_constrs.push_back(c.operator->());
+                cls.push_back(*ls);
+                std::sort(cls.back().begin(), cls.back().end(), [](const auto &l0, const auto &l1)
+                          { return index(l0) < index(l1); });
+                sigs.push_back(signature(cls.back()));
+                for (const auto &l : cls.back())
+                    occs[index(l)].push_back(cls.size() - 1);
+            }
+
+        // we check whether `c` subsumes `d`, possibly after flipping one of its literals, returning in `flip` the literal of `d` which can be removed (or the undefined literal, if `c` subsumes `d`)..
+        const auto subsumes = [](const std::vector<lit> &c, const std::vector<lit> &d, lit &flip)
+        {
+            flip = lit();
+            size_t j = 0;
+            for (const auto &l : c)
+            {
+                while (j < d.size() && variable(d[j]) < variable(l))
+                    ++j;
+                if (j == d.size() || variable(d[j]) != variable(l))
+                    return false;
+                if (d[j] != l)
+                {
+                    if (!is_undefined(flip))
+                        return false; // at most one literal can be flipped..
+                    flip = d[j];
+                }
+                ++j;
+            }
+            return true;
+        };
+
+        // the clauses are checked, against the other clauses, from the shortest ones..
+        std::vector<size_t> q(cls.size());
+        for (size_t id = 0; id < q.size(); ++id)
+            q[id] = id;
+        std::stable_sort(q.begin(), q.end(), [&cls](const auto &c0, const auto &c1)
+                         { return cls[c0].size() < cls[c1].size(); });
+        std::vector<bool> in_q(cls.size(), true), removed(cls.size(), false), strengthened(cls.size(), false);
+        std::vector<lit> units;
+        size_t steps = 0;
+        for (size_t qi = 0; qi < q.size() && steps < budget; ++qi)
+        {
+            const size_t c_id = q[qi];
+            in_q[c_id] = false;
+            if (removed[c_id])
+                continue;
+            const auto &c = cls[c_id];
+            // the subsumed, or strengthened, clauses contain either the literal of `c` having the fewest occurrences or its negation..
+            lit best = c[0];
+            for (const auto &l : c)
+                if (occs[index(l)].size() + occs[index(!l)].size() < occs[index(best)].size() + occs[index(!best)].size())
+                    best = l;
+            for (const auto &l : {best, !best})
+            {
+                const std::vector<size_t> ds = occs[index(l)]; // the occurrence lists might change while strengthening..
+                for (const auto &d_id : ds)
+                {
+                    if (d_id == c_id || removed[d_id] || cls[d_id].size() < c.size() || (sigs[c_id] & ~sigs[d_id]))
+                        continue;
+                    auto &d = cls[d_id];
+                    steps += c.size() + d.size();
+                    lit flip;
+                    if (!subsumes(c, d, flip))
+                        continue;
+                    if (is_undefined(flip)) // `c` subsumes `d`..
+                        removed[d_id] = true;
+                    else
+                    { // self-subsuming resolution: `d` is strengthened by removing the flipped literal..
+                        d.erase(std::find(d.begin(), d.end(), flip));
+                        auto &f_occs = occs[index(flip)];
+                        f_occs.erase(std::find(f_occs.begin(), f_occs.end(), d_id));
+                        sigs[d_id] = signature(d);
+                        strengthened[d_id] = true;
+                        if (d.size() == 1)
+                        { // the clause has become unit..
+                            units.push_back(d[0]);
+                            removed[d_id] = true;
+                        }
+                        else if (!in_q[d_id])
+                        { // the strengthened clause might subsume other clauses..
+                            in_q[d_id] = true;
+                            q.push_back(d_id);
+                        }
+                    }
+                }
+            }
+        }
+
+        // we replace the removed and the strengthened clauses..
+        bool detached = false;
+        for (size_t id = 0; id < cls.size(); ++id)
+            if (removed[id] || strengthened[id])
+            {
+                c_constrs[id]->detached = true;
+                detached = true;
+            }
+        if (detached)
+            remove_detached();
+        for (size_t id = 0; id < cls.size(); ++id)
+            if (strengthened[id] && !removed[id])
+                constrs.push_back(new clause(*this, std::move(cls[id])));
+        for (const auto &u : units)
+            if (!enqueue(u))
+                return false;
+        return simplify_db();
+    }
+
+    SEMITONE_EXPORT bool sat_core::eliminate(const size_t &budget) noexcept
+    {
+        assert(root_level());
+        if (!simplify_db())
+            return false;
+        lookaheads.clear(); // the cached lookaheads might refer to the removed variables..
+
+        // the variables of the reified expressions might be returned again to the user, hence they are frozen..
+        for (const auto &[s_expr, l] : exprs)
+            if (s_expr[0] != 'b')
+                frozen[variable(l)] = true;
+
+        // we collect the clauses along with the occurrence lists of the literals..
+        std::vector<constr *> c_constrs;
+        std::vector<std::vector<lit>> cls;
+        std::vector<bool> alive;
+        std::vector<std::vector<size_t>> occs(watches.size());
+        for (auto &c : constrs)
+            if (const auto ls = c->get_clause())
+            {
+                for (const auto &l : *ls)
+                    occs[index(l)].push_back(cls.size());
+                c_constrs.push_back(c.operator->());
+                cls.push_back(*ls);
+                alive.push_back(true);
+            }
+        const size_t n_orig = cls.size();
+
+        // the candidates are tried starting from those having the fewest potential resolvents..
+        std::vector<var> cands;
+        for (var x = 0; x < assigns.size(); ++x)
+            if (value(x) == utils::Undefined && !frozen[x] && !eliminated[x] && (!occs[index(lit(x))].empty() || !occs[index(!lit(x))].empty()))
+                cands.push_back(x);
+        std::stable_sort(cands.begin(), cands.end(), [&occs](const var &x0, const var &x1)
+                         { return occs[index(lit(x0))].size() * occs[index(!lit(x0))].size() < occs[index(lit(x1))].size() * occs[index(!lit(x1))].size(); });
+
+        // we compute the resolvent of `c0` and `c1` on variable `x`, returning false if it is a tautology..
+        const auto resolve = [](const std::vector<lit> &c0, const std::vector<lit> &c1, const var &x, std::vector<lit> &r)
+        {
+            for (const auto &l : c0)
+                if (variable(l) != x)
+                    r.push_back(l);
+            const size_t n_c0 = r.size();
+            for (const auto &l : c1)
+                if (variable(l) != x)
+                {
+                    if (std::find(r.cbegin(), r.cbegin() + n_c0, !l) != r.cbegin() + n_c0)
+                        return false;
+                    if (std::find(r.cbegin(), r.cbegin() + n_c0, l) == r.cbegin() + n_c0)
+                        r.push_back(l);
+                }
+            return true;
+        };
+
+        size_t steps = 0;
+        for (const auto &x : cands)
+        {
+            if (steps >= budget)
+                break;
+            std::vector<size_t> pos, neg;
+            for (const auto &id : occs[index(lit(x))])
+                if (alive[id])
+                    pos.push_back(id);
+            for (const auto &id : occs[index(!lit(x))])
+                if (alive[id])
+                    neg.push_back(id);
+
+            // we compute the resolvents, giving up as soon as they outnumber the clauses they would replace..
+            std::vector<std::vector<lit>> resolvents;
+            bool grows = false;
+            for (size_t i = 0; i < pos.size() && !grows; ++i)
+                for (size_t j = 0; j < neg.size() && !grows; ++j)
+                {
+                    steps += cls[pos[i]].size() + cls[neg[j]].size();
+                    std::vector<lit> r;
+                    if (resolve(cls[pos[i]], cls[neg[j]], x, r))
+                    {
+                        resolvents.push_back(std::move(r));
+                        grows = resolvents.size() > pos.size() + neg.size();
+                    }
+                }
+            if (grows)
+                continue;
+
+            // we eliminate the variable, storing the clauses of the smaller side for extending the models..
+            eliminated[x] = true;
+            const bool pos_side = pos.size() <= neg.size();
+            const lit pivot = pos_side ? lit(x) : !lit(x);
+            for (const auto &id : pos_side ? pos : neg)
+            {
+                std::vector<lit> e_cls{pivot};
+                for (const auto &l : cls[id])
+                    if (variable(l) != x)
+                        e_cls.push_back(l);
+                elim_stack.push_back(std::move(e_cls));
+            }
+            elim_stack.push_back({!pivot}); // the pivot is false unless some of its clauses requires it..
+            for (const auto &id : pos)
+                alive[id] = false;
+            for (const auto &id : neg)
+                alive[id] = false;
+            for (auto &r : resolvents)
+            {
+                if (r.empty())
+                    return false; // the formula is unsatisfiable..
+                for (const auto &l : r)
+                    occs[index(l)].push_back(cls.size());
+                cls.push_back(std::move(r));
+                alive.push_back(true);
+            }
+        }
+
+        // we replace the resolved clauses with the resolvents..
+        bool detached = false;
+        for (size_t id = 0; id < n_orig; ++id)
+            if (!alive[id])
+            {
+                c_constrs[id]->detached = true;
+                detached = true;
+            }
+        if (detached)
+            remove_detached();
+        std::vector<lit> units;
+        for (size_t id = n_orig; id < cls.size(); ++id)
+            if (alive[id])
+            {
+                if (cls[id].size() == 1)
+                    units.push_back(cls[id][0]);
+                else
+                    constrs.push_back(new clause(*this, std::move(cls[id])));
+            }
+        for (const auto &u : units)
+            if (!enqueue(u))
+                return false;
+        return simplify_db();
+    }
+
+    SEMITONE_EXPORT bool sat_core::substitute() noexcept
+    {
+        assert(root_level());
+        if (!simplify_db())
+            return false;
+        lookaheads.clear(); // the cached lookaheads might refer to the removed variables..
+
+        // we build the implication graph of the binary clauses..
+        std::vector<std::vector<size_t>> imps(watches.size());
+        for (const auto &c : constrs)
+            if (const auto ls = c->get_clause(); ls && ls->size() == 2)
+            {
+                imps[index(!(*ls)[0])].push_back(index((*ls)[1]));
+                imps[index(!(*ls)[1])].push_back(index((*ls)[0]));
+            }
+
+        // we find the strongly connected components of the implication graph through an iterative version of Tarjan's algorithm..
+        constexpr size_t unvisited = std::numeric_limits<size_t>::max();
+        std::vector<size_t> idx(imps.size(), unvisited), low(imps.size()), comp(imps.size(), unvisited);
+        std::vector<size_t> stack, comp_lits;
+        std::vector<size_t> comp_lims{0};
+        std::vector<std::pair<size_t, size_t>> call_stack; // the visited node and the position of its next successor..
+        size_t c_idx = 0;
+        for (size_t root = 0; root < imps.size(); ++root)
+            if (idx[root] == unvisited && !imps[root].empty())
+            {
+                call_stack.emplace_back(root, 0);
+                idx[root] = low[root] = c_idx++;
+                stack.push_back(root);
+                while (!call_stack.empty())
+                {
+                    auto &[n, i] = call_stack.back();
+                    if (i < imps[n].size())
+                    {
+                        const size_t w = imps[n][i++];
+                        if (idx[w] == unvisited)
+                        {
+                            idx[w] = low[w] = c_idx++;
+                            stack.push_back(w);
+                            call_stack.emplace_back(w, 0);
+                        }
+                        else if (comp[w] == unvisited)
+                            low[n] = std::min(low[n], idx[w]);
+                    }
+                    else
+                    {
+                        const size_t v = n;
+                        call_stack.pop_back();
+                        if (!call_stack.empty())
+                            low[call_stack.back().first] = std::min(low[call_stack.back().first], low[v]);
+                        if (low[v] == idx[v])
+                        { // `v` is the root of a strongly connected component..
+                            size_t w;
+                            do
+                            {
+                                w = stack.back();
+                                stack.pop_back();
+                                comp[w] = comp_lims.size() - 1;
+                                comp_lits.push_back(w);
+                            } while (w != v);
+                            comp_lims.push_back(comp_lits.size());
+                        }
+                    }
+                }
+            }
+
+        // we choose a representative for each component, substituting its non-frozen variables..
+        bool substituted = false;
+        for (size_t c = 0; c + 1 < comp_lims.size(); ++c)
+        {
+            if (comp_lims[c + 1] - comp_lims[c] < 2)
+                continue;
+            lit rep;
+            for (size_t i = comp_lims[c]; i < comp_lims[c + 1]; ++i)
+            {
+                const lit l(comp_lits[i] >> 1, comp_lits[i] & 1);
+                if (comp[index(!l)] == c)
+                    return false; // a literal is equivalent to its negation..
+                if (is_undefined(rep) || (frozen[variable(l)] && !frozen[variable(rep)]) || (frozen[variable(l)] == frozen[variable(rep)] && variable(l) < variable(rep)))
+                    rep = l;
+            }
+            if (!sign(rep))
+                continue; // the dual component will take care of the substitution..
+            for (size_t i = comp_lims[c]; i < comp_lims[c + 1]; ++i)
+            {
+                const lit l(comp_lits[i] >> 1, comp_lits[i] & 1);
+                if (variable(l) != variable(rep) && !frozen[variable(l)])
+                {
+                    substs[variable(l)] = sign(l) ? rep : !rep;
+                    eliminated[variable(l)] = true;
+                    elim_stack.push_back({lit(variable(l)), !substs[variable(l)]});
+                    elim_stack.push_back({!lit(variable(l)), substs[variable(l)]});
+                    substituted = true;
+                }
+            }
+        }
+        if (!substituted)
+            return true;
+
+        // we compress the substitutions, so that each substituted variable refers to a variable which has never been substituted..
+        for (auto &s : substs)
+            if (!is_undefined(s) && !is_undefined(substs[variable(s)]))
+                s = sign(s) ? substs[variable(s)] : !substs[variable(s)];
+
+        // we rewrite the clauses containing the substituted variables..
+        std::vector<std::vector<lit>> n_cls;
+        for (auto &c : constrs)
+            if (const auto ls = c->get_clause(); ls && std::any_of(ls->cbegin(), ls->cend(), [this](const auto &l)
+                                                                   { return !is_undefined(substs[variable(l)]); }))
+            {
+                std::vector<lit> n_ls;
+                bool taut = false;
+                for (const auto &l : *ls)
+                {
+                    const lit r = representative(l);
+                    if (std::find(n_ls.cbegin(), n_ls.cend(), !r) != n_ls.cend())
+                    {
+                        taut = true;
+                        break;
+                    }
+                    if (std::find(n_ls.cbegin(), n_ls.cend(), r) == n_ls.cend())
+                        n_ls.push_back(r);
+                }
+                if (!taut)
+                    n_cls.push_back(std::move(n_ls));
+                c->detached = true;
+            }
+        remove_detached();
+        std::vector<lit> units;
+        for (auto &ls : n_cls)
+            if (ls.size() == 1)
+                units.push_back(ls[0]);
             else
-                ++i;
+                constrs.push_back(new clause(*this, std::move(ls)));
+
+        // the reified expressions now refer to the representatives..
+        for (auto &[s_expr, l] : exprs)
+            l = representative(l);
+
+        for (const auto &u : units)
+            if (!enqueue(u))
+                return false;
+        return simplify_db();
+    }
+
+    SEMITONE_EXPORT std::vector<utils::lbool> sat_core::get_model() const noexcept
+    {
+        std::vector<utils::lbool> model = assigns;
+        // we extend the model, starting from the last eliminated variable, by satisfying the stored clauses through their first literal..
+        for (auto it = elim_stack.crbegin(); it != elim_stack.crend(); ++it)
+            if (std::none_of(std::next(it->cbegin()), it->cend(), [&model](const auto &l)
+                             { return model[variable(l)] == (sign(l) ? utils::True : utils::False); }))
+                model[variable(it->front())] = sign(it->front()) ? utils::True : utils::False;
+        return model;
+    }
+
+    void sat_core::remove_detached() noexcept
+    {
+        // we sweep, in a single pass, the watch lists containing the detached constraints..
+        std::vector<lit> c_watched;
+        for (const auto &c : constrs)
+            if (c->detached)
+                c->get_watched(c_watched);
+        std::sort(c_watched.begin(), c_watched.end(), [](const auto &l0, const auto &l1)
+                  { return index(l0) < index(l1); });
+        c_watched.erase(std::unique(c_watched.begin(), c_watched.end()), c_watched.end());
+        for (const auto &l : c_watched)
+        {
+            auto &ws = watches[index(l)];
+            ws.erase(std::remove_if(ws.begin(), ws.end(), [](const constr *c)
+                                    { return c->detached; }),
+                     ws.end());
+        }
+        // .. and the reasons of the (root-level) assignments..
+        for (auto &r : reason)
+            if (r && r->detached)
+                r = nullptr;
+
+        size_t j = 0;
+        for (size_t i = 0; i < constrs.size(); ++i)
+            if (!constrs[i]->detached)
+            {
+                if (i != j)
+                    constrs[i].swap(constrs[j]);
+                ++j;
+            }
         constrs.resize(j);
-        return true;
     }
 
     SEMITONE_EXPORT bool sat_core::propagate() noexcept
+    {
+        const bool was_propagating = propagating;
+        propagating = true;
+        interrupted = false;
+        const bool consistent = propagate_queue();
+        propagating = was_propagating;
+        if (!propagating)
+            notify_listeners();
+        return consistent;
+    }
+
+    bool sat_core::propagate_queue() noexcept
     {
         lit p;
     main_loop:
         while (!prop_q.empty())
         { // we first propagate sat constraints..
+            if (!within_budget())
+                return false; // the propagation is interrupted, the literals still to be propagated remain in the queue..
+            ++n_propagations;
+            SEMITONE_STATS(++stats.propagations);
             p = prop_q.front();
             prop_q.pop();
             std::vector<constr *> tmp;
             std::swap(tmp, watches[index(p)]);
             for (size_t i = 0; i < tmp.size(); ++i)
+            {
+                SEMITONE_STATS(++stats.watch_visits);
                 if (!tmp[i]->propagate(p))
                 { // the constraint is conflicting..
                     for (size_t j = i + 1; j < tmp.size(); ++j)
@@ -413,23 +942,26 @@ namespace semitone
 
                     if (root_level())
                         return false;
+                    ++n_conflicts;
+                    SEMITONE_STATS(++stats.conflicts);
                     std::vector<lit> no_good;
                     size_t bt_level;
                     // we analyze the conflict..
                     analyze(*tmp[i], no_good, bt_level);
-                    while (decision_level() > bt_level)
-                        pop();
+                    backjump(bt_level);
                     // we record the no-good..
                     record(no_good);
 
                     goto main_loop;
                 }
+            }
 
             // we then perform theory propagation..
             if (const auto bnds_it = bounds.find(variable(p)); bnds_it != bounds.cend())
             {
                 for (const auto &th : bnds_it->second)
-                    if (!th->propagate(p))
+                    if (!timed(th->th_stats.propagates, th->th_stats.propagate_time, [&th, &p]
+                               { return th->propagate(p); }))
                     {
                         while (!prop_q.empty())
                             prop_q.pop();
@@ -441,6 +973,8 @@ namespace semitone
                         }
 
                         // we analyze the theory's conflict, create a no-good from the analysis and backjump..
+                        ++n_conflicts;
+                        SEMITONE_STATS(++stats.conflicts);
                         th->analyze_and_backjump();
                         goto main_loop;
                     }
@@ -451,7 +985,11 @@ namespace semitone
 
         // finally, we check theories..
         for (const auto &th : theories)
-            if (!th->check())
+        {
+            if (!within_budget())
+                return false; // the propagation is interrupted before checking the theory..
+            if (!timed(th->th_stats.checks, th->th_stats.check_time, [&th]
+                       { return th->check(); }))
             {
                 if (root_level())
                 {
@@ -460,9 +998,16 @@ namespace semitone
                 }
 
                 // we analyze the theory's conflict, create a no-good from the analysis and backjump..
+                ++n_conflicts;
+                SEMITONE_STATS(++stats.conflicts);
                 th->analyze_and_backjump();
                 goto main_loop;
             }
+            if (interrupted)
+                return false; // the theory has been interrupted while checking..
+        }
+        if (!prop_q.empty()) // the theories might have propagated some literals while checking..
+            goto main_loop;
 
         return true;
     }
@@ -476,7 +1021,11 @@ namespace semitone
         no_good.reserve(decisions.size());
         for (const auto &l : decisions)
             no_good.push_back(!l);
+        // the implications missed by chronological backtracking are re-enqueued once the no-good is recorded..
+        const bool was_propagating = propagating;
+        propagating = true;
         pop();
+        propagating = was_propagating;
 
         assert(!no_good.empty());
         assert(value(no_good.back()) == utils::Undefined);
@@ -490,6 +1039,7 @@ namespace semitone
 
     SEMITONE_EXPORT bool sat_core::check(std::vector<lit> lits) noexcept
     {
+        to_representatives(lits);
         const size_t c_rl = decision_level(); // the current root-level..
         size_t c_dl;                          // the current decision-level..
         for (const auto &p : lits)
@@ -508,13 +1058,450 @@ namespace semitone
         return true;
     }
 
+    SEMITONE_EXPORT bool sat_core::check(const std::vector<lit> &lits, std::vector<lit> &unsat_core, const size_t &max_checks) noexcept
+    {
+        // the assumptions are checked through their representatives, while the failed ones are returned as given..
+        std::vector<lit> r_lits(lits);
+        to_representatives(r_lits);
+        const size_t c_rl = decision_level(); // the current root-level..
+        const bool consistent = assume_all(r_lits, unsat_core);
+        while (decision_level() > c_rl)
+            pop();
+        if (consistent || interrupted)
+        {
+            unsat_core.clear();
+            return consistent;
+        }
+
+        // we try to remove the failed assumptions one at a time, restricting the core to the failed assumptions of each inconsistent subset..
+        std::vector<lit> c_lits, c_failed;
+        size_t n_checks = 0;
+        for (size_t i = 0; i < unsat_core.size() && n_checks < max_checks && decision_level() == c_rl; ++n_checks)
+        {
+            c_lits.clear();
+            for (size_t j = 0; j < unsat_core.size(); ++j)
+                if (j != i)
+                    c_lits.push_back(unsat_core[j]);
+            const bool c_consistent = assume_all(c_lits, c_failed);
+            while (decision_level() > c_rl)
+                pop();
+            if (interrupted)
+                break; // the current core is still valid..
+            if (c_consistent)
+                ++i; // the `i`-th literal is necessary..
+            else
+                std::swap(unsat_core, c_failed);
+        }
+        for (auto &l : unsat_core)
+        {
+            const auto at_l = std::find(r_lits.cbegin(), r_lits.cend(), l);
+            assert(at_l != r_lits.cend());
+            l = lits[at_l - r_lits.cbegin()];
+        }
+        return false;
+    }
+
+    bool sat_core::assume_all(const std::vector<lit> &lits, std::vector<lit> &out_failed) noexcept
+    {
+        const size_t c_rl = decision_level(); // the current root-level..
+        out_failed.clear();
+        size_t i = 0;
+        while (i < lits.size())
+        {
+            if (value(lits[i]) == utils::False)
+            { // the assumption is implied false, hence we look for the assumptions responsible for it..
+                analyze_final(lits[i], c_rl, out_failed);
+                return false;
+            }
+            const size_t c_dl = decision_level();
+            if (!assume(lits[i]))
+                return false; // the current assignment is inconsistent by itself..
+            if (decision_level() <= c_dl)
+            { // a conflict led to a backjump, hence we resume from the assumptions which are still in place..
+                if (decision_level() < c_rl)
+                { // the backjump undid some of the decisions which precede the assumptions..
+                    out_failed = lits;
+                    return false;
+                }
+                i = decision_level() - c_rl;
+            }
+            else
+                ++i;
+        }
+        return true;
+    }
+
+    void sat_core::analyze_final(const lit &p, const size_t &c_rl, std::vector<lit> &out_failed) noexcept
+    {
+        assert(value(p) == utils::False);
+        out_failed.push_back(p);
+        if (level[variable(p)] <= c_rl)
+            return; // `p` is false regardless of the assumptions..
+
+        std::vector<bool> seen(assigns.size(), false);
+        seen[variable(p)] = true;
+        std::vector<lit> p_reason;
+        for (size_t i = trail.size(); i > trail_lim[c_rl]; --i)
+        {
+            const lit &q = trail[i - 1];
+            if (!seen[variable(q)])
+                continue;
+            if (!reason[variable(q)])
+                out_failed.push_back(q); // `q` is an assumption..
+            else
+            {
+                p_reason.clear();
+                reason[variable(q)]->get_reason(q, p_reason);
+                for (const auto &r : p_reason)
+                    if (level[variable(r)] > c_rl)
+                        seen[variable(r)] = true;
+            }
+        }
+    }
+
+    SEMITONE_EXPORT bool sat_core::backbone(const std::vector<lit> &cands, std::vector<lit> &out_backbone, const size_t &chunk_size) noexcept
+    {
+        assert(root_level());
+        assert(chunk_size > 0);
+        out_backbone.clear();
+        if (solve({}) != utils::True)
+            return false;
+
+        // the candidates are checked through their representatives, while the backbone is returned in terms of the given candidates..
+        const auto to_cands = [this, &cands, &out_backbone]
+        {
+            std::vector<bool> in_backbone(watches.size(), false);
+            for (const auto &p : out_backbone)
+                in_backbone[index(p)] = true;
+            out_backbone.clear();
+            for (const auto &p : cands)
+                if (in_backbone[index(representative(p))])
+                    out_backbone.push_back(p);
+        };
+
+        // the candidates which are false in the model are not in the backbone..
+        std::vector<lit> c_cands;
+        for (const auto &p : cands)
+        {
+            const lit r = representative(p);
+            assert(!eliminated[variable(r)]);
+            if (value(r) == utils::True)
+                c_cands.push_back(r);
+        }
+        while (!root_level())
+            pop();
+
+        while (!c_cands.empty())
+        {
+            // the candidates already true at root level are in the backbone..
+            c_cands.erase(std::remove_if(c_cands.begin(), c_cands.end(), [this, &out_backbone](const auto &p)
+                                         {  if (value(p) != utils::True)
+                                                return false;
+                                            out_backbone.push_back(p);
+                                            return true; }),
+                          c_cands.end());
+            if (c_cands.empty())
+                break;
+
+            // we look for a model which falsifies at least one of the candidates of the chunk..
+            const std::vector<lit> chunk(c_cands.cend() - std::min(chunk_size, c_cands.size()), c_cands.cend());
+            lit act;
+            utils::lbool found;
+            if (chunk.size() == 1)
+                found = solve({!chunk[0]});
+            else
+            { // the chunk's clause is activated by a fresh literal, so that it can be later disabled..
+                act = lit(new_var());
+                std::vector<lit> c_lits{!act};
+                for (const auto &p : chunk)
+                    c_lits.push_back(!p);
+                [[maybe_unused]] bool nc = new_clause(std::move(c_lits));
+                assert(nc);
+                found = solve({act});
+            }
+
+            if (found == utils::Undefined)
+            { // the search has been interrupted, or the formula is inconsistent..
+                if (interrupted && !is_undefined(act))
+                { // we disable the chunk's clause, whose activation literal occurs nowhere else, hence its (trivial) propagation is not subject to the budget..
+                    const sat_budget c_budget = budget;
+                    budget = {};
+                    [[maybe_unused]] bool prop = enqueue(!act) && propagate();
+                    assert(prop);
+                    budget = c_budget;
+                    interrupted = true;
+                }
+                to_cands();
+                return false;
+            }
+            if (found == utils::True)
+            { // the candidates which are false in the new model are not in the backbone..
+                c_cands.erase(std::remove_if(c_cands.begin(), c_cands.end(), [this](const auto &p)
+                                             { return value(p) != utils::True; }),
+                              c_cands.end());
+                while (!root_level())
+                    pop();
+            }
+            else
+            { // all the candidates of the chunk are in the backbone..
+                for (const auto &p : chunk)
+                    if (value(p) == utils::Undefined && !enqueue(p))
+                        return false;
+                c_cands.resize(c_cands.size() - chunk.size());
+                out_backbone.insert(out_backbone.cend(), chunk.cbegin(), chunk.cend());
+            }
+            if (!is_undefined(act) && !enqueue(!act))
+                return false;
+            if (!propagate())
+                return false;
+        }
+        to_cands();
+        return simplify_db();
+    }
+
+    SEMITONE_EXPORT size_t sat_core::enumerate(const std::vector<var> &vars, const std::function<bool(const std::vector<lit> &)> &callback, const size_t &limit) noexcept
+    {
+        assert(root_level());
+        // the substituted variables are projected through their representatives..
+        std::vector<var> c_vars;
+        std::vector<bool> is_proj(assigns.size(), false);
+        for (const auto &v : vars)
+        {
+            const var r = variable(representative(lit(v)));
+            assert(!eliminated[r]);
+            if (!is_proj[r])
+            {
+                is_proj[r] = true;
+                c_vars.push_back(r);
+            }
+        }
+
+        const lit act(new_var()); // the literal guarding the blocking clauses..
+        size_t n_models = 0;
+        std::vector<lit> proj, no_good;
+        utils::lbool found = utils::False;
+        while (n_models < limit && (found = solve({act}, c_vars)) == utils::True)
+        {
+            proj.clear();
+            for (const auto &v : vars)
+                proj.push_back(lit(v, value(v) == utils::True));
+
+            // we block the projection decisions, the other projection literals being implied by them..
+            no_good = {!act};
+            for (const auto &d : decisions)
+                if (variable(d) < is_proj.size() && is_proj[variable(d)])
+                    no_good.push_back(!d);
+            while (!root_level())
+                pop();
+            ++n_models;
+            if (!new_clause(std::move(no_good)) || !propagate())
+            { // the blocking clauses can always be disabled, hence the formula is inconsistent by itself..
+                found = utils::Undefined;
+                break;
+            }
+            if (!callback(proj))
+                break;
+        }
+        if (found == utils::Undefined && !interrupted)
+            return n_models; // the formula is inconsistent by itself..
+
+        // we disable the blocking clauses..
+        while (!root_level())
+            pop();
+        if (value(act) == utils::Undefined && enqueue(!act))
+            simplify_db();
+        return n_models;
+    }
+
+    utils::lbool sat_core::solve(const std::vector<lit> &lits, const std::vector<var> &prefs) noexcept
+    {
+        assert(root_level());
+        size_t c_pref = 0; // the preferred variables preceding `c_pref` are assigned..
+        var x = 0;         // the variables preceding `x` are assigned..
+        while (true)
+        {
+            // we (re)assume the assumptions which are not in place, possibly after a backjump..
+            while (decision_level() < lits.size())
+            {
+                const lit &p = lits[decision_level()];
+                if (value(p) == utils::False)
+                { // the assumptions are inconsistent..
+                    while (!root_level())
+                        pop();
+                    return utils::False;
+                }
+                if (!assume(p))
+                { // the search has been interrupted, or the formula is inconsistent..
+                    while (interrupted && !root_level())
+                        pop();
+                    return utils::Undefined;
+                }
+                c_pref = 0;
+                x = 0;
+            }
+
+            // we decide the next unassigned variable, if any, starting from the preferred ones..
+            while (c_pref < prefs.size() && (assigns[prefs[c_pref]] != utils::Undefined || eliminated[prefs[c_pref]]))
+                ++c_pref;
+            lit d;
+            if (c_pref < prefs.size())
+                d = lit(prefs[c_pref], false);
+            else
+            {
+                while (x < assigns.size() && (assigns[x] != utils::Undefined || eliminated[x]))
+                    ++x;
+                if (x == assigns.size())
+                    return utils::True; // all the variables are assigned, hence we have a model..
+                d = lit(x, false);
+            }
+            const size_t c_dl = decision_level();
+            if (!assume(d))
+            { // the search has been interrupted, or the formula is inconsistent..
+                while (interrupted && !root_level())
+                    pop();
+                return utils::Undefined;
+            }
+            if (decision_level() <= c_dl)
+            { // a conflict led to a backjump..
+                c_pref = 0;
+                x = 0;
+            }
+        }
+    }
+
+    SEMITONE_EXPORT bool sat_core::probe(const std::vector<lit> &cands) noexcept
+    {
+        assert(root_level());
+        // the substituted candidates are probed through their representatives..
+        std::vector<lit> r_cands;
+        r_cands.reserve(cands.size());
+        for (const auto &p : cands)
+            r_cands.push_back(representative(p));
+        if (!propagate())
+            return false;
+
+        std::vector<size_t> stamps(watches.size(), 0); // the literals implied by the positive polarity of the current candidate..
+        size_t c_stamp = 0, c_root;
+        std::vector<lit> pos_implied, neg_implied;
+        bool failed;
+        do
+        { // we probe the candidates until no new literal is asserted at root level, so that the cached lookaheads remain valid..
+            c_root = trail.size();
+            for (const auto &p : r_cands)
+            {
+                if (value(p) != utils::Undefined || eliminated[variable(p)])
+                    continue;
+                if (!probe_lit(p, pos_implied, failed))
+                    return false;
+                if (failed)
+                    continue;
+                if (!probe_lit(!p, neg_implied, failed))
+                    return false;
+                if (failed)
+                    continue;
+
+                // the literals implied by both the polarities of `p` are necessary..
+                ++c_stamp;
+                for (const auto &l : pos_implied)
+                    stamps[index(l)] = c_stamp;
+                bool asserted = false;
+                for (const auto &l : neg_implied)
+                    if (stamps[index(l)] == c_stamp && value(l) == utils::Undefined)
+                    {
+                        if (!enqueue(l))
+                            return false;
+                        asserted = true;
+                    }
+                if (asserted && !propagate())
+                    return false;
+            }
+        } while (c_root != trail.size());
+        return true;
+    }
+
+    SEMITONE_EXPORT bool sat_core::lookahead(const lit &p, std::vector<lit> &implied) noexcept
+    {
+        assert(root_level());
+        const lit q = representative(p); // the substituted literals are looked ahead through their representatives..
+        assert(!eliminated[variable(q)]);
+        switch (value(q))
+        {
+        case utils::True:
+            implied = {q};
+            return true;
+        case utils::False:
+            return false;
+        default:
+            bool failed;
+            return probe_lit(q, implied, failed) && !failed;
+        }
+    }
+
+    bool sat_core::probe_lit(const lit &p, std::vector<lit> &implied, bool &failed) noexcept
+    {
+        assert(root_level());
+        if (lookaheads_root != trail.size())
+        { // the root level has changed since the lookaheads have been cached..
+            lookaheads.clear();
+            lookaheads_root = trail.size();
+        }
+        failed = false;
+        if (const auto at_p = lookaheads.find(index(p)); at_p != lookaheads.cend())
+        {
+            implied = at_p->second;
+            return true;
+        }
+
+        const size_t c_trail = trail.size();
+        if (!assume(p))
+        { // the probing has been interrupted, or the root level is inconsistent..
+            while (!root_level())
+                pop();
+            return false;
+        }
+        if (root_level())
+        { // the assumption of `p` led to a conflict and to a backjump to the root level, hence `p` is a failed literal..
+            failed = true;
+            switch (value(p))
+            {
+            case utils::True:
+                return false;
+            case utils::False:
+                return true;
+            default:
+                return enqueue(!p) && propagate();
+            }
+        }
+        implied.assign(trail.cbegin() + c_trail, trail.cend());
+        pop();
+        lookaheads.emplace(index(p), implied);
+        return true;
+    }
+
     void sat_core::analyze(constr &cnfl, std::vector<lit> &out_learnt, size_t &out_btlevel) noexcept
+    {
+        std::vector<lit> p_reason;
+        cnfl.get_reason(lit(), p_reason);
+        analyze_reason(std::move(p_reason), out_learnt, out_btlevel);
+    }
+
+    void sat_core::analyze(const lit *cnfl, const size_t &n_lits, std::vector<lit> &out_learnt, size_t &out_btlevel) noexcept
+    {
+        std::vector<lit> p_reason;
+        p_reason.reserve(n_lits);
+        for (size_t i = 0; i < n_lits; ++i)
+        {
+            assert(value(cnfl[i]) == utils::False);
+            p_reason.push_back(!cnfl[i]);
+        }
+        analyze_reason(std::move(p_reason), out_learnt, out_btlevel);
+    }
+
+    void sat_core::analyze_reason(std::vector<lit> p_reason, std::vector<lit> &out_learnt, size_t &out_btlevel) noexcept
     {
         std::set<var> seen;
         int counter = 0; // this is the number of variables of the current decision level that have already been seen..
         lit p;
-        std::vector<lit> p_reason;
-        cnfl.get_reason(p, p_reason);
         out_learnt.push_back(p);
         out_btlevel = 0;
         do
@@ -551,6 +1538,8 @@ namespace semitone
         assert(std::all_of(std::next(out_learnt.cbegin()), out_learnt.cend(), [this](auto &lt)
                            { return value(lt) == utils::False; })); // all these literals must have been assigned as false for propagating `p`..
         out_learnt[0] = !p;
+        SEMITONE_STATS(++stats.learnts);
+        SEMITONE_STATS(stats.learnt_lits += out_learnt.size());
     }
 
     void sat_core::record(std::vector<lit> lits) noexcept
@@ -575,16 +1564,81 @@ namespace semitone
                       { return level[variable(a)] > level[variable(b)]; });
 
             auto l0 = lits[0];
+            const size_t c_level = level[variable(lits[1])]; // the level at which the clause implies `l0`..
             auto c = new clause(*this, std::move(lits));
             [[maybe_unused]] bool e = enqueue(l0, c);
             assert(e);
             constrs.push_back(c);
+            if (c_level < decision_level()) // chronological backtracking assigns `l0` above its level, hence it might need to be re-enqueued after a subsequent backtracking..
+                missed.emplace_back(l0, c, c_level);
+        }
+        requeue();
+    }
+
+    void sat_core::to_representatives(std::vector<lit> &ls) const noexcept
+    {
+        for (auto &l : ls)
+        {
+            l = representative(l);
+            assert(!eliminated[variable(l)]);
+        }
+    }
+
+    bool sat_core::within_budget(const size_t &pivots) noexcept
+    {
+        if ((budget.interrupt && budget.interrupt->load(std::memory_order_relaxed)) ||
+            n_conflicts >= budget.conflicts || n_propagations >= budget.propagations || n_pivots + pivots > budget.pivots ||
+            (budget.deadline != std::chrono::steady_clock::time_point::max() && std::chrono::steady_clock::now() >= budget.deadline))
+        {
+            interrupted = true;
+            return false;
         }
+        n_pivots += pivots;
+        return true;
+    }
+
+    void sat_core::backjump(const size_t &bt_level) noexcept
+    {
+        // the long backjumps are replaced, if required, by the retraction of the last decision level only, while the learnt units always lead to the root level..
+        const size_t c_level = bt_level > 0 && decision_level() - bt_level > chrono_threshold ? decision_level() - 1 : bt_level;
+        while (decision_level() > c_level)
+            pop();
+    }
+
+    bool sat_core::requeue() noexcept
+    {
+        bool requeued = false;
+        for (size_t i = 0; i < missed.size();)
+        {
+            const auto &[p, c, c_level] = missed[i];
+            assert(c_level <= decision_level());
+            if (value(p) == utils::Undefined)
+            {
+                [[maybe_unused]] bool e = enqueue(p, c);
+                assert(e);
+                requeued = true;
+            }
+            else if (value(p) == utils::False)
+            { // the reason is violated by the asserting literal just recorded, whose propagation will detect the conflict..
+                missed[i] = missed.back();
+                missed.pop_back();
+                continue;
+            }
+            if (level[variable(p)] == c_level)
+            { // the literal is now assigned at its own level..
+                missed[i] = missed.back();
+                missed.pop_back();
+            }
+            else
+                ++i;
+        }
+        return requeued;
     }
 
     bool sat_core::enqueue(const lit &p, constr *const c) noexcept
     {
-        if (auto val = value(p); val != utils::Undefined)
+        assert(is_undefined(substs[variable(p)]));
+        if (auto val = assigned(p); val != utils::Undefined)
             return val;
         else
         {
@@ -597,7 +1651,7 @@ namespace semitone
             if (const auto at_p = listening.find(variable(p)); at_p != listening.cend())
             {
                 for (const auto &l : at_p->second)
-                    l->sat_value_change(variable(p));
+                    l->value_change(variable(p), utils::Undefined);
                 if (root_level()) // since this variable will no more be assigned, we can perform some cleanings..
                     listening.erase(at_p);
             }
@@ -608,13 +1662,20 @@ namespace semitone
     void sat_core::pop_one() noexcept
     {
         const var v = variable(trail.back());
+        const utils::lbool val = assigns[v];
         assigns[v] = utils::Undefined;
         level[v] = 0;
         reason[v] = nullptr;
         trail.pop_back();
         if (const auto at_v = listening.find(v); at_v != listening.cend())
             for (const auto &l : at_v->second)
-                l->sat_value_change(v);
+                l->value_change(v, val);
+    }
+
+    void sat_core::notify_listeners() noexcept
+    {
+        for (const auto &l : listeners)
+            l->notify();
     }
 
     SEMITONE_EXPORT json::json to_json(const sat_core &rhs) noexcept
@@ -648,6 +1709,15 @@ namespace semitone
             j_asrts.push_back(to_json(*c));
         j_th["constrs"] = std::move(j_asrts);
 
+        json::json j_stats;
+        j_stats["decisions"] = rhs.stats.decisions;
+        j_stats["propagations"] = rhs.stats.propagations;
+        j_stats["conflicts"] = rhs.stats.conflicts;
+        j_stats["learnts"] = rhs.stats.learnts;
+        j_stats["learnt_lits"] = rhs.stats.learnt_lits;
+        j_stats["watch_visits"] = rhs.stats.watch_visits;
+        j_th["stats"] = std::move(j_stats);
+
         return j_th;
     }
 } // namespace semitone
\ No newline at end of file
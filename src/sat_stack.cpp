@@ -35,6 +35,8 @@ namespace semitone
         for (const auto &p : trail)
             if (const auto at_p = stack.back()->listening.find(variable(p)); at_p != stack.back()->listening.cend())
                 for (const auto &l : at_p->second)
-                    l->sat_value_change(variable(p));
+                    l->value_change(variable(p), sign(p) ? utils::True : utils::False);
+        for (const auto &l : stack.back()->listeners)
+            l->notify();
     }
 } // namespace semitone
\ No newline at end of file
@@ -1,6 +1,5 @@
 #include "theory.h"
 #include "sat_core.h"
-#include "clause.h"
 #include <algorithm>
 
 namespace semitone
@@ -33,20 +32,35 @@ namespace semitone
 
     void theory::analyze_and_backjump() noexcept
     {
-        // we create a conflict clause for the analysis..
-        clause cnfl_cl(*sat, std::move(cnfl));
-
-        // .. and we analyze the conflict..
+        // we analyze the conflict, without creating a constraint for representing it..
         std::vector<lit> no_good;
         size_t bt_level;
-        sat->analyze(cnfl_cl, no_good, bt_level);
+        sat->analyze(cnfl.data(), cnfl.size(), no_good, bt_level);
         cnfl.clear();
 
         // we backjump..
-        while (sat->decision_level() > bt_level)
-            sat->pop();
+        sat->backjump(bt_level);
         // .. and record the no-good..
         sat->record(no_good);
     }
     SEMITONE_EXPORT void theory::record(std::vector<lit> cls) noexcept { sat->record(std::move(cls)); }
+    SEMITONE_EXPORT bool theory::within_budget(const size_t &pivots) noexcept { return sat->within_budget(pivots); }
+    SEMITONE_EXPORT bool theory::is_propagating() const noexcept { return sat->propagating; }
+
+    SEMITONE_EXPORT json::json to_json(const theory_stats &rhs) noexcept
+    {
+        const auto ms = [](const std::chrono::steady_clock::duration &d)
+        { return std::chrono::duration<double, std::milli>(d).count(); };
+
+        json::json j_stats;
+        j_stats["propagates"] = rhs.propagates;
+        j_stats["propagate_ms"] = ms(rhs.propagate_time);
+        j_stats["checks"] = rhs.checks;
+        j_stats["check_ms"] = ms(rhs.check_time);
+        j_stats["pushes"] = rhs.pushes;
+        j_stats["push_ms"] = ms(rhs.push_time);
+        j_stats["pops"] = rhs.pops;
+        j_stats["pop_ms"] = ms(rhs.pop_time);
+        return j_stats;
+    }
 } // namespace semitone
\ No newline at end of file
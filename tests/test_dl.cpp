@@ -1,5 +1,7 @@
 #include "idl_theory.h"
 #include "rdl_theory.h"
+#include "idl_value_listener.h"
+#include <algorithm>
 #include <cassert>
 
 using namespace semitone;
@@ -575,6 +577,597 @@ void test_semantic_branching()
     assert(bound_horizon.first == utils::inf_rational(utils::rational(10), 1) && bound_horizon.second == utils::inf_rational(utils::rational(20), -1));
 }
 
+void test_backtracking()
+{
+    auto core = sat_ptr(new sat_core());
+    idl_theory idl(core, 5);
+    var origin = idl.new_var();
+    // origin >= 0..
+    bool nc = core->new_clause({idl.new_distance(origin, 0, 0)});
+    assert(nc);
+    var horizon = idl.new_var();
+    // horizon >= origin..
+    nc = core->new_clause({idl.new_distance(horizon, origin, 0)});
+    assert(nc);
+    var tp = idl.new_var();
+    // origin <= tp <= horizon..
+    nc = core->new_clause({idl.new_distance(tp, origin, 0)});
+    assert(nc);
+    nc = core->new_clause({idl.new_distance(horizon, tp, 0)});
+    assert(nc);
+    bool prop = core->propagate();
+    assert(prop);
+
+    lit horizon_leq_20 = idl.new_leq(lin(horizon, utils::rational::ONE), lin(utils::rational(20)));
+    lit horizon_leq_10 = idl.new_leq(lin(horizon, utils::rational::ONE), lin(utils::rational(10)));
+    lit tp_geq_5 = idl.new_geq(lin(tp, utils::rational::ONE), lin(utils::rational(5)));
+
+    bool assm = core->assume(horizon_leq_20);
+    assert(assm);
+    assert(idl.bounds(tp).second == 20);
+
+    // the same cells are updated twice within the same level..
+    assm = core->assume(tp_geq_5);
+    assert(assm);
+    assert(idl.bounds(tp).first == 5 && idl.bounds(horizon).first == 5);
+    assm = core->assume(horizon_leq_10);
+    assert(assm);
+    assert(idl.bounds(tp).first == 5 && idl.bounds(tp).second == 10);
+    assert(idl.distance(origin, horizon).second == 10);
+
+    core->pop();
+    assert(idl.bounds(tp).first == 5 && idl.bounds(tp).second == 20);
+    core->pop();
+    assert(idl.bounds(tp).first == 0 && idl.bounds(tp).second == 20);
+    assert(idl.bounds(horizon).first == 0);
+    core->pop();
+    assert(idl.bounds(tp).first == 0 && idl.bounds(tp).second == idl_theory::inf());
+    assert(idl.distance(origin, horizon).second == idl_theory::inf());
+}
+
+void test_sparse_0()
+{
+    auto core = sat_ptr(new sat_core());
+    idl_theory idl(core, 5, true);
+    var origin = idl.new_var();
+    var horizon = idl.new_var();
+    bool nc = core->new_clause({idl.new_distance(horizon, origin, 0)});
+    assert(nc);
+
+    var tp0 = idl.new_var();
+    nc = core->new_clause({idl.new_distance(tp0, origin, 0)});
+    assert(nc);
+    nc = core->new_clause({idl.new_distance(horizon, tp0, 0)});
+    assert(nc);
+
+    var tp1 = idl.new_var();
+    nc = core->new_clause({idl.new_distance(tp1, origin, 0)});
+    assert(nc);
+    nc = core->new_clause({idl.new_distance(horizon, tp1, 0)});
+    assert(nc);
+
+    var tp2 = idl.new_var();
+    nc = core->new_clause({idl.new_distance(tp2, origin, 0)});
+    assert(nc);
+    nc = core->new_clause({idl.new_distance(horizon, tp2, 0)});
+    assert(nc);
+    bool prop = core->propagate();
+    assert(prop);
+
+    nc = core->new_clause({idl.new_distance(tp0, tp1, 10)});
+    assert(nc);
+    nc = core->new_clause({idl.new_distance(tp1, tp0, 0)});
+    assert(nc);
+
+    nc = core->new_clause({idl.new_distance(tp1, tp2, 10)});
+    assert(nc);
+    nc = core->new_clause({idl.new_distance(tp2, tp1, 0)});
+    assert(nc);
+
+    nc = core->new_clause({idl.new_distance(origin, tp0, 10)});
+    assert(nc);
+    prop = core->propagate();
+    assert(prop);
+
+    lit tp2_after_40 = idl.new_distance(tp2, origin, -40);
+    assert(tp2_after_40 == FALSE_lit);
+
+    lit tp2_after_20 = idl.new_distance(tp2, origin, -20);
+    lit tp2_before_20 = idl.new_distance(origin, tp2, 20);
+
+    lit tp2_after_30 = idl.new_distance(tp2, origin, -30);
+    lit tp2_before_30 = idl.new_distance(origin, tp2, 30);
+
+    nc = core->new_clause({core->new_disj({core->new_conj({tp2_after_20, tp2_before_20}), core->new_conj({tp2_after_30, tp2_before_30})})});
+    assert(nc);
+
+    nc = core->new_clause({idl.new_distance(origin, tp2, 30)});
+    assert(nc);
+    nc = core->new_clause({idl.new_distance(tp2, origin, -25)});
+    assert(nc);
+
+    prop = core->propagate();
+    assert(prop);
+
+    std::pair<utils::I, utils::I> dist_origin_tp2 = idl.distance(origin, tp2);
+    assert(dist_origin_tp2.first == 30 && dist_origin_tp2.second == 30);
+}
+
+void test_sparse_1()
+{
+    auto core = sat_ptr(new sat_core());
+    idl_theory idl(core, 5, true);
+    var origin = idl.new_var();
+    // origin >= 0..
+    bool nc = core->new_clause({idl.new_distance(origin, 0, 0)});
+    assert(nc);
+    var horizon = idl.new_var();
+    // horizon >= origin..
+    nc = core->new_clause({idl.new_distance(horizon, origin, 0)});
+    assert(nc);
+    bool prop = core->propagate();
+    assert(prop);
+    std::pair<utils::I, utils::I> bound_horizon = idl.bounds(horizon);
+    assert(bound_horizon.first == 0 && bound_horizon.second == idl_theory::inf());
+
+    lit horizon_leq_15 = idl.new_leq(lin(horizon, utils::rational::ONE), lin(utils::rational(15)));
+    lit horizon_leq_20 = idl.new_leq(lin(horizon, utils::rational::ONE), lin(utils::rational(20)));
+    lit origin_gt_15 = idl.new_gt(lin(origin, utils::rational::ONE), lin(utils::rational(15)));
+
+    // we assume the horizon to be at most 15 and check the implied literals..
+    bool assm = core->assume(horizon_leq_15);
+    assert(assm);
+    assert(core->value(horizon_leq_20) == utils::True);
+    assert(core->value(origin_gt_15) == utils::False);
+    bound_horizon = idl.bounds(horizon);
+    assert(bound_horizon.first == 0 && bound_horizon.second == 15);
+    assert(idl.bounds(origin).second == 15);
+
+    // we backtrack, restoring the previous bounds..
+    core->pop();
+    assert(core->value(horizon_leq_20) == utils::Undefined);
+    assert(core->value(origin_gt_15) == utils::Undefined);
+    bound_horizon = idl.bounds(horizon);
+    assert(bound_horizon.first == 0 && bound_horizon.second == idl_theory::inf());
+
+    // the origin after 15 forces the horizon after 15 (negative cycle detection)..
+    assm = core->assume(origin_gt_15);
+    assert(assm);
+    assert(core->value(horizon_leq_15) == utils::False);
+    assert(idl.bounds(horizon).first == 16);
+}
+
+void test_idl32()
+{
+    auto core = sat_ptr(new sat_core());
+    idl32_theory idl(core, 5);
+    var origin = idl.new_var();
+    // origin >= 0..
+    bool nc = core->new_clause({idl.new_distance(origin, 0, 0)});
+    assert(nc);
+    var tp = idl.new_var();
+    // origin <= tp..
+    nc = core->new_clause({idl.new_distance(tp, origin, 0)});
+    assert(nc);
+    bool prop = core->propagate();
+    assert(prop);
+    assert(idl.bounds(tp).first == 0 && idl.bounds(tp).second == idl32_theory::inf());
+
+    // tp <= 10.5 (rounded to tp <= 10)..
+    nc = core->new_clause({idl.new_leq(lin(tp, utils::rational::ONE), lin(utils::rational(21, 2)))});
+    assert(nc);
+    // tp > 2.5 (rounded to tp >= 3)..
+    nc = core->new_clause({idl.new_gt(lin(tp, utils::rational::ONE), lin(utils::rational(5, 2)))});
+    assert(nc);
+    prop = core->propagate();
+    assert(prop);
+    assert(idl.bounds(tp).first == 3 && idl.bounds(tp).second == 10);
+
+    // tp < 10 (i.e., tp <= 9)..
+    lit tp_lt_10 = idl.new_lt(lin(tp, utils::rational::ONE), lin(utils::rational(10)));
+    // an integer variable cannot be equal to 3.5..
+    assert(idl.new_eq(lin(tp, utils::rational::ONE), lin(utils::rational(7, 2))) == FALSE_lit);
+    assert(idl.matches(lin(tp, utils::rational::ONE), lin(utils::rational(10))));
+
+    bool assm = core->assume(tp_lt_10);
+    assert(assm);
+    assert(idl.bounds(tp).second == 9);
+    assert(!idl.matches(lin(tp, utils::rational::ONE), lin(utils::rational(10))));
+    core->pop();
+    assert(idl.bounds(tp).second == 10);
+}
+
+class counting_idl_listener : public idl_value_listener
+{
+public:
+    counting_idl_listener(idl_theory &th, const var &v, const bool batched) : idl_value_listener(th, batched) { listen_idl(v); }
+
+    size_t n_calls = 0;
+
+private:
+    void idl_value_change(const var &) override { ++n_calls; }
+    void idl_values_change(const std::vector<var> &vs) override
+    {
+        ++n_calls;
+        assert(vs.size() == 1);
+    }
+};
+
+void test_batched_listener()
+{
+    auto core = sat_ptr(new sat_core());
+    idl_theory idl(core, 5);
+    var tp0 = idl.new_var();
+    var tp1 = idl.new_var();
+
+    counting_idl_listener eager(idl, tp1, false);
+    counting_idl_listener batched(idl, tp1, true);
+
+    // tp0 >= 5, tp1 >= tp0 + 2 and tp1 <= 20..
+    bool nc = core->new_clause({idl.new_distance(tp0, 0, -5)});
+    assert(nc);
+    nc = core->new_clause({idl.new_distance(tp1, tp0, -2)});
+    assert(nc);
+    nc = core->new_clause({idl.new_distance(0, tp1, 20)});
+    assert(nc);
+
+    bool prop = core->propagate();
+    assert(prop);
+    assert(idl.bounds(tp1).first == 7 && idl.bounds(tp1).second == 20);
+
+    // the bounds of `tp1` change several times within the propagation, but the batched listener is notified once..
+    assert(eager.n_calls > 1);
+    assert(batched.n_calls == 1);
+}
+
+void test_sparse_listener()
+{
+    auto core = sat_ptr(new sat_core());
+    idl_theory idl(core, 5, true);
+    var tp0 = idl.new_var();
+    var tp1 = idl.new_var();
+
+    counting_idl_listener l0(idl, tp0, false);
+    counting_idl_listener l1(idl, tp1, false);
+
+    // tp0 >= 5..
+    bool nc = core->new_clause({idl.new_distance(tp0, 0, -5)});
+    assert(nc);
+    bool prop = core->propagate();
+    assert(prop);
+    assert(l0.n_calls == 1);
+    // the bounds of `tp1` are not affected, hence its listener is not notified..
+    assert(l1.n_calls == 0);
+
+    // tp1 >= tp0 + 2..
+    nc = core->new_clause({idl.new_distance(tp1, tp0, -2)});
+    assert(nc);
+    prop = core->propagate();
+    assert(prop);
+    assert(idl.bounds(tp1).first == 7);
+    assert(l0.n_calls == 1);
+    assert(l1.n_calls == 1);
+
+    // tp1 >= 3 is already entailed, hence no listener is notified..
+    nc = core->new_clause({idl.new_distance(tp1, 0, -3)});
+    assert(nc);
+    prop = core->propagate();
+    assert(prop);
+    assert(l0.n_calls == 1);
+    assert(l1.n_calls == 1);
+}
+
+void test_pop_listener()
+{
+    for (const bool sparse : {false, true})
+    {
+        auto core = sat_ptr(new sat_core());
+        idl_theory idl(core, 5, sparse);
+        var tp0 = idl.new_var();
+        var tp1 = idl.new_var();
+
+        // tp0 >= 5..
+        bool nc = core->new_clause({idl.new_distance(tp0, 0, -5)});
+        assert(nc);
+        bool prop = core->propagate();
+        assert(prop);
+
+        counting_idl_listener l0(idl, tp0, false);
+        counting_idl_listener l1(idl, tp1, false);
+
+        // tp1 >= tp0 + 2..
+        bool assm = core->assume(idl.new_distance(tp1, tp0, -2));
+        assert(assm);
+        assert(idl.bounds(tp1).first == 7);
+        assert(l0.n_calls == 0);
+        const size_t n_calls = l1.n_calls;
+        assert(n_calls > 0);
+
+        // the lower bound of `tp1` is restored, hence its listener is notified..
+        core->pop();
+        assert(idl.bounds(tp1).first == -idl_theory::inf());
+        assert(l0.n_calls == 0);
+        assert(l1.n_calls > n_calls);
+    }
+}
+
+void test_rdl_sparse()
+{
+    auto core = sat_ptr(new sat_core());
+    rdl_theory rdl(core, 5, true);
+    var origin = rdl.new_var();
+    // origin >= 0..
+    bool nc = core->new_clause({rdl.new_distance(origin, 0, utils::inf_rational(utils::rational::ZERO))});
+    assert(nc);
+    var horizon = rdl.new_var();
+    // horizon >= origin..
+    nc = core->new_clause({rdl.new_distance(horizon, origin, utils::inf_rational(utils::rational::ZERO))});
+    assert(nc);
+    bool prop = core->propagate();
+    assert(prop);
+
+    lit horizon_leq_20 = rdl.new_leq(lin(horizon, utils::rational::ONE), lin(utils::rational(20)));
+    lit horizon_lt_10 = rdl.new_lt(lin(horizon, utils::rational::ONE), lin(utils::rational(10)));
+
+    bool assm = core->assume(!horizon_leq_20);
+    assert(assm);
+    // horizon > 20 entails !(horizon < 10)..
+    assert(core->value(horizon_lt_10) == utils::False);
+    assert(rdl.bounds(horizon).first == utils::inf_rational(utils::rational(20), 1));
+    core->pop();
+    assert(rdl.bounds(horizon).first == utils::inf_rational(utils::rational::ZERO));
+    assert(core->value(horizon_lt_10) == utils::Undefined);
+}
+
+void test_propagation_budget()
+{
+    auto core = sat_ptr(new sat_core());
+    idl_theory idl(core, 5);
+    var origin = idl.new_var();
+    // origin >= 0..
+    bool nc = core->new_clause({idl.new_distance(origin, 0, 0)});
+    assert(nc);
+    var horizon = idl.new_var();
+    // horizon >= origin..
+    nc = core->new_clause({idl.new_distance(horizon, origin, 0)});
+    assert(nc);
+    bool prop = core->propagate();
+    assert(prop);
+
+    lit horizon_leq_20 = idl.new_leq(lin(horizon, utils::rational::ONE), lin(utils::rational(20)));
+    lit horizon_leq_10 = idl.new_leq(lin(horizon, utils::rational::ONE), lin(utils::rational(10)));
+    lit horizon_gt_15 = idl.new_gt(lin(horizon, utils::rational::ONE), lin(utils::rational(15)));
+
+    // no constraint is checked, hence nothing is propagated..
+    idl.set_propagation_budget(0);
+    bool assm = core->assume(horizon_leq_10);
+    assert(assm);
+    assert(idl.bounds(horizon).second == 10);
+    assert(core->value(horizon_leq_20) == utils::Undefined);
+    assert(core->value(horizon_gt_15) == utils::Undefined);
+    core->pop();
+
+    idl.set_propagation_budget(std::numeric_limits<size_t>::max());
+    assm = core->assume(horizon_leq_10);
+    assert(assm);
+    assert(core->value(horizon_leq_20) == utils::True);
+    assert(core->value(horizon_gt_15) == utils::False);
+    core->pop();
+}
+
+void test_chain_explanation()
+{
+    auto core = sat_ptr(new sat_core());
+    idl_theory idl(core, 5);
+    var origin = idl.new_var();
+    // origin >= 0..
+    bool nc = core->new_clause({idl.new_distance(origin, 0, 0)});
+    assert(nc);
+    bool prop = core->propagate();
+    assert(prop);
+
+    std::vector<var> chain{origin};
+    std::vector<lit> links;
+    for (size_t i = 0; i < 10; ++i)
+    {
+        chain.push_back(idl.new_var());
+        // chain[i + 1] >= chain[i] + 1..
+        links.push_back(idl.new_distance(chain[i + 1], chain[i], -1));
+    }
+    lit end_leq_9 = idl.new_leq(lin(chain.back(), utils::rational::ONE), lin(utils::rational(9)));
+    lit end_leq_10 = idl.new_leq(lin(chain.back(), utils::rational::ONE), lin(utils::rational(10)));
+    nc = core->new_clause({end_leq_10});
+    assert(nc);
+    prop = core->propagate();
+    assert(prop);
+
+    for (const auto &l : links)
+    {
+        bool assm = core->assume(l);
+        assert(assm);
+    }
+    // the whole chain is required for entailing the lower bound of its end..
+    assert(idl.bounds(chain.back()).first == 10);
+    assert(core->value(end_leq_9) == utils::False);
+    assert(idl.distance(origin, chain.back()).first == 10 && idl.distance(origin, chain.back()).second == 10);
+    core->pop();
+    assert(core->value(end_leq_9) == utils::Undefined);
+    while (!core->root_level())
+        core->pop();
+
+    // the last link would close a negative cycle, hence it is propagated as false..
+    nc = core->new_clause({end_leq_9});
+    assert(nc);
+    prop = core->propagate();
+    assert(prop);
+    for (size_t i = 0; i < links.size() - 1; ++i)
+    {
+        bool assm = core->assume(links[i]);
+        assert(assm);
+    }
+    assert(core->value(links.back()) == utils::False);
+}
+
+void test_rigid_components()
+{
+    auto core = sat_ptr(new sat_core());
+    idl_theory idl(core, 5);
+    var a = idl.new_var();
+    var b = idl.new_var();
+    // a >= 10..
+    bool nc = core->new_clause({idl.new_distance(a, 0, -10)});
+    assert(nc);
+    bool prop = core->propagate();
+    assert(prop);
+
+    lit b_leq = idl.new_distance(a, b, 5);   // b - a <= 5..
+    lit b_geq = idl.new_distance(b, a, -5);  // a - b <= -5..
+    lit b_gt = idl.new_distance(b, a, -6);   // a - b <= -6..
+    lit a_leq_20 = idl.new_leq(lin(a, utils::rational::ONE), lin(utils::rational(20)));
+    lit a_leq_19 = idl.new_leq(lin(a, utils::rational::ONE), lin(utils::rational(19)));
+    lit b_leq_24 = idl.new_leq(lin(b, utils::rational::ONE), lin(utils::rational(24)));
+    lit b_leq_14 = idl.new_leq(lin(b, utils::rational::ONE), lin(utils::rational(14)));
+
+    bool assm = core->assume(b_leq);
+    assert(assm);
+    assm = core->assume(b_geq);
+    assert(assm);
+    // `a` and `b` are now rigidly connected..
+    assert(idl.distance(a, b).first == 5 && idl.distance(a, b).second == 5);
+    assert(idl.bounds(b).first == 15);
+    assert(core->value(b_gt) == utils::False);
+
+    // the bounds of `a` are transferred to `b`..
+    assm = core->assume(a_leq_20);
+    assert(assm);
+    assert(idl.bounds(b).second == 25);
+    assert(core->value(b_leq_24) == utils::Undefined);
+    assm = core->assume(a_leq_19);
+    assert(assm);
+    assert(idl.bounds(b).second == 24);
+    assert(core->value(b_leq_24) == utils::True);
+
+    // the rigid component is split on backtracking..
+    core->pop();
+    core->pop();
+    core->pop();
+    assert(idl.distance(a, b).second == 5);
+    assert(idl.distance(a, b).first < 5);
+    assert(idl.bounds(b).first < 15);
+    assert(core->value(b_gt) == utils::False); // still inconsistent with `b - a <= 5`..
+    assert(core->value(b_leq_24) == utils::Undefined);
+
+    // the propagations are explained through the component, whichever its representative..
+    assm = core->assume(b_geq);
+    assert(assm);
+    assm = core->assume(b_leq);
+    assert(assm);
+    assm = core->assume(a_leq_19);
+    assert(assm);
+    assert(core->value(b_leq_24) == utils::True);
+    assert(core->value(b_leq_14) == utils::False);
+}
+void test_parallel_relaxation()
+{
+    auto core = sat_ptr(new sat_core());
+    idl_theory seq(core, 8);
+    idl_theory par(core, 8);
+    par.set_parallelism(4, 0);
+    assert(par.get_n_threads() == 4);
+
+    // a grid of precedences, whose relaxations touch many rows at once..
+    std::vector<var> s_vars, p_vars;
+    std::vector<lit> s_lits, p_lits;
+    for (size_t i = 0; i < 40; ++i)
+    {
+        s_vars.push_back(seq.new_var());
+        p_vars.push_back(par.new_var());
+    }
+    for (size_t i = 0; i < 40; ++i)
+        for (size_t j = i + 1; j < 40; j += 7)
+        {
+            const auto dist = -static_cast<utils::I>((i * 3 + j) % 5) - 1;
+            s_lits.push_back(seq.new_distance(s_vars[j], s_vars[i], dist));
+            p_lits.push_back(par.new_distance(p_vars[j], p_vars[i], dist));
+        }
+
+    for (size_t i = 0; i < s_lits.size(); i += 2)
+    {
+        if (core->value(s_lits[i]) != utils::Undefined)
+            continue;
+        bool assm = core->assume(s_lits[i]);
+        assert(assm);
+        assm = core->assume(p_lits[i]);
+        assert(assm);
+        // the parallel relaxation yields the same distances and propagations as the sequential one..
+        for (size_t j = 0; j < s_vars.size(); ++j)
+        {
+            assert(seq.bounds(s_vars[j]) == par.bounds(p_vars[j]));
+            assert(seq.distance(s_vars[0], s_vars[j]) == par.distance(p_vars[0], p_vars[j]));
+        }
+        for (size_t j = 0; j < s_lits.size(); ++j)
+            assert(core->value(s_lits[j]) == core->value(p_lits[j]));
+    }
+    while (!core->root_level())
+        core->pop();
+    for (size_t j = 0; j < s_vars.size(); ++j)
+        assert(seq.bounds(s_vars[j]) == par.bounds(p_vars[j]));
+#ifndef NO_STATISTICS
+    // the parallel relaxation updates the same cells as the sequential one..
+    assert(seq.get_stats().edges == par.get_stats().edges);
+    assert(seq.get_stats().cells == par.get_stats().cells);
+#endif
+}
+
+void test_statistics()
+{
+    auto core = sat_ptr(new sat_core());
+    idl_theory dense(core, 5);
+    idl_theory sparse(core, 5, true);
+
+    var d0 = dense.new_var();
+    var d1 = dense.new_var();
+    var s0 = sparse.new_var();
+    var s1 = sparse.new_var();
+
+    // d1 - d0 <= -2, hence d0 >= d1 + 2..
+    bool assm = core->assume(dense.new_distance(d0, d1, -2));
+    assert(assm);
+    assm = core->assume(sparse.new_distance(s0, s1, -2));
+    assert(assm);
+
+#ifndef NO_STATISTICS
+    assert(dense.get_stats().edges == 1);
+    assert(dense.get_stats().cells > 0);
+    assert(sparse.get_stats().edges == 1);
+    assert(sparse.get_stats().cells > 0);
+    assert(dense.get_theory_stats().propagates == 1);
+    assert(dense.get_theory_stats().pushes == 2);
+#endif
+
+    [[maybe_unused]] auto j_dense = to_json(dense);
+    [[maybe_unused]] auto j_sparse = to_json(sparse);
+}
+void test_lookahead_invalidation()
+{
+    auto core = sat_ptr(new sat_core());
+    idl_theory idl(core);
+    var tp0 = idl.new_var();
+    var tp1 = idl.new_var();
+
+    lit tp1_before_tp0 = idl.new_distance(tp0, tp1, 0);
+    std::vector<lit> implied;
+    bool la = core->lookahead(tp1_before_tp0, implied);
+    assert(la);
+    assert(implied.size() == 1);
+
+    // the new constraint, bound to the theory, is implied by the probed literal, hence the cached lookahead is no more valid..
+    lit tp1_before_tp0_5 = idl.new_distance(tp0, tp1, 5);
+    la = core->lookahead(tp1_before_tp0, implied);
+    assert(la);
+    assert(std::find(implied.cbegin(), implied.cend(), tp1_before_tp0_5) != implied.cend());
+}
+
 int main(int, char **)
 {
     test_config();
@@ -589,4 +1182,21 @@ int main(int, char **)
     test_constraints_5();
 
     test_semantic_branching();
+
+    test_backtracking();
+    test_propagation_budget();
+    test_chain_explanation();
+    test_rigid_components();
+    test_parallel_relaxation();
+    test_statistics();
+
+    test_sparse_0();
+    test_sparse_1();
+
+    test_idl32();
+    test_batched_listener();
+    test_sparse_listener();
+    test_pop_listener();
+    test_rdl_sparse();
+    test_lookahead_invalidation();
 }
\ No newline at end of file
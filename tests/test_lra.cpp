@@ -1,6 +1,8 @@
 #include "sat_core.h"
 #include "lra_theory.h"
+#include "lra_value_listener.h"
 #include "sat_stack.h"
+#include <algorithm>
 #include <cassert>
 
 using namespace semitone;
@@ -115,6 +117,63 @@ void test_inequalities_1()
     assert(y_val == utils::rational::ONE);
 }
 
+class counting_lra_listener : public lra_value_listener
+{
+public:
+    counting_lra_listener(lra_theory &th, const std::vector<var> &vars, const bool batched) : lra_value_listener(th, batched)
+    {
+        for (const auto &v : vars)
+            listen_lra(v);
+    }
+
+    size_t n_calls = 0;
+    std::vector<var> changed;
+
+private:
+    void lra_value_change(const var &v) override
+    {
+        ++n_calls;
+        changed.push_back(v);
+    }
+    void lra_values_change(const std::vector<var> &vars) override
+    {
+        ++n_calls;
+        changed = vars;
+    }
+};
+
+void test_batched_listener()
+{
+    auto core = sat_ptr(new sat_core());
+    lra_theory lra(core);
+
+    var x = lra.new_var();
+    var y = lra.new_var();
+
+    counting_lra_listener eager(lra, {x, y}, false);
+    counting_lra_listener batched(lra, {x, y}, true);
+
+    // x >= y
+    bool nc = core->new_clause({lra.new_geq(lin(x, utils::rational::ONE), lin(y, utils::rational::ONE))});
+    assert(nc);
+    // y >= 1
+    nc = core->new_clause({lra.new_geq(lin(y, utils::rational::ONE), lin(utils::rational::ONE))});
+    assert(nc);
+    assert(batched.n_calls == 0);
+
+    bool prop = core->propagate();
+    assert(prop);
+    assert(lra.value(x) == utils::rational::ONE);
+    assert(lra.value(y) == utils::rational::ONE);
+
+    // the batched listener is notified once, when the theory is found consistent, with each changed variable once..
+    assert(eager.n_calls >= 2);
+    assert(batched.n_calls == 1);
+    assert(batched.changed.size() == 2);
+    assert(std::count(batched.changed.cbegin(), batched.changed.cend(), x) == 1);
+    assert(std::count(batched.changed.cbegin(), batched.changed.cend(), y) == 1);
+}
+
 void test_strict_inequalities_0()
 {
     auto core = sat_ptr(new sat_core());
@@ -217,6 +276,108 @@ void test_nonroot_constraints()
     assert(!prop);
 }
 
+void test_backbone()
+{
+    auto core = sat_ptr(new sat_core());
+    lra_theory lra(core);
+
+    var x = lra.new_var();
+    var y = lra.new_var();
+    var a = core->new_var();
+
+    // x >= 2 and y <= 1
+    bool nc = core->new_clause({lra.new_geq(lin(x, utils::rational::ONE), lin(utils::rational(2)))});
+    assert(nc);
+    nc = core->new_clause({lra.new_leq(lin(y, utils::rational::ONE), lin(utils::rational::ONE))});
+    assert(nc);
+
+    // `x <= y` is inconsistent with the bounds, hence `a` and `x >= 5` are in the backbone..
+    lit x_leq_y = lra.new_leq(lin(x, utils::rational::ONE), lin(y, utils::rational::ONE));
+    lit x_geq_5 = lra.new_geq(lin(x, utils::rational::ONE), lin(utils::rational(5)));
+    lit y_leq_0 = lra.new_leq(lin(y, utils::rational::ONE), lin(utils::rational::ZERO));
+    nc = core->new_clause({lit(a), x_leq_y});
+    assert(nc);
+    nc = core->new_clause({!lit(a), x_geq_5});
+    assert(nc);
+
+    bool prop = core->propagate();
+    assert(prop);
+
+    std::vector<lit> bb;
+    bool bbn = core->backbone({lit(a), x_geq_5, y_leq_0, !y_leq_0}, bb);
+    assert(bbn);
+    assert(bb.size() == 2);
+    assert(std::find(bb.cbegin(), bb.cend(), lit(a)) != bb.cend());
+    assert(std::find(bb.cbegin(), bb.cend(), x_geq_5) != bb.cend());
+    assert(core->value(x_geq_5) == utils::True);
+    assert(lra.lb(x) >= utils::rational(5));
+}
+
+void test_budget()
+{
+    auto core = sat_ptr(new sat_core());
+    lra_theory lra(core);
+
+    var x = lra.new_var();
+    var y = lra.new_var();
+
+    // x + y <= 1
+    bool nc = core->new_clause({lra.new_leq(lin(x, utils::rational::ONE) + lin(y, utils::rational::ONE), lin(utils::rational::ONE))});
+    assert(nc);
+    bool prop = core->propagate();
+    assert(prop);
+
+    lit x_geq_2 = lra.new_geq(lin(x, utils::rational::ONE), lin(utils::rational(2)));
+
+    // without pivots, the simplex cannot fix the violated row..
+    sat_budget budget;
+    budget.pivots = 0;
+    core->set_budget(budget);
+    bool assm = core->assume(x_geq_2);
+    assert(!assm);
+    assert(core->is_interrupted());
+    assert(core->decision_level() == 1);
+
+    // a new budget resumes the check..
+    core->set_budget({});
+    prop = core->propagate();
+    assert(prop);
+    assert(!core->is_interrupted());
+    assert(lra.value(x) >= utils::rational(2));
+    assert(lra.value(x) + lra.value(y) <= utils::rational::ONE);
+}
+
+void test_statistics()
+{
+    auto core = sat_ptr(new sat_core());
+    lra_theory lra(core);
+
+    var x = lra.new_var();
+    var y = lra.new_var();
+
+    // x + y <= 1
+    bool nc = core->new_clause({lra.new_leq(lin(x, utils::rational::ONE) + lin(y, utils::rational::ONE), lin(utils::rational::ONE))});
+    assert(nc);
+    bool prop = core->propagate();
+    assert(prop);
+
+    // x >= 2 requires a pivot..
+    bool assm = core->assume(lra.new_geq(lin(x, utils::rational::ONE), lin(utils::rational(2))));
+    assert(assm);
+    core->pop();
+
+#ifndef NO_STATISTICS
+    assert(lra.get_stats().pivots == 1);
+    const auto &th_stats = lra.get_theory_stats();
+    assert(th_stats.propagates == 2); // the root-level constraint and the assumption..
+    assert(th_stats.checks >= 2);
+    assert(th_stats.pushes == 1);
+    assert(th_stats.pops == 1);
+#endif
+
+    [[maybe_unused]] auto j_lra = to_json(lra);
+}
+
 void test_sat_stack_0()
 {
     sat_stack stack;
@@ -282,11 +443,16 @@ int main(int, char **)
     test_lra_theory();
     test_inequalities_0();
     test_inequalities_1();
+    test_batched_listener();
 
     test_strict_inequalities_0();
     test_strict_inequalities_1();
 
     test_nonroot_constraints();
 
+    test_backbone();
+    test_budget();
+    test_statistics();
+
     test_sat_stack_0();
 }
\ No newline at end of file
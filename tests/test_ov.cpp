@@ -1,5 +1,6 @@
 #include "sat_core.h"
 #include "ov_theory.h"
+#include "ov_value_listener.h"
 #include <cassert>
 
 using namespace semitone;
@@ -118,9 +119,332 @@ void test_ov_2()
     assert(eq0 == eq2);
 }
 
+void test_ov_eq_within_search()
+{
+    auto core = sat_ptr(new sat_core());
+    ov_theory ov(core);
+
+    test_val a;
+    test_val b;
+
+    var x = ov.new_var({&a, &b});
+    var y = ov.new_var({&a, &b});
+
+    bool prop = core->propagate();
+    assert(prop);
+
+    // x == a and y == b..
+    bool assm = core->assume(ov.allows(x, a));
+    assert(assm);
+    assm = core->assume(!ov.allows(y, a));
+    assert(assm);
+    assert(core->value(ov.allows(y, b)) == utils::True);
+
+    // the assignments within the search do not decide the equality, since they are retracted on backtracking, yet they assign its literal..
+    lit x_eq_y = ov.new_eq(x, y);
+    assert(variable(x_eq_y) != FALSE_var);
+    assert(core->value(x_eq_y) == utils::False);
+
+    core->pop();
+    core->pop();
+    assert(core->root_level());
+
+    // the equality is still controlled by the same literal, which is now unassigned..
+    assert(ov.new_eq(x, y) == x_eq_y);
+    assert(core->value(x_eq_y) == utils::Undefined);
+    assm = core->assume(x_eq_y);
+    assert(assm);
+}
+
+void test_ov_domain()
+{
+    auto core = sat_ptr(new sat_core());
+    ov_theory ov(core);
+
+    test_val a;
+    test_val b;
+    test_val c;
+    test_val d;
+
+    var v0 = ov.new_var({&c, &a, &b});
+    var v1 = ov.new_var({&a});
+
+    assert(ov.domain_size(v0) == 3);
+    assert(ov.contains(v0, a) && ov.contains(v0, b) && ov.contains(v0, c));
+    assert(!ov.contains(v0, d));
+    assert(ov.allows(v0, d) == FALSE_lit);
+    assert(ov.domain_size(v1) == 1);
+    assert(ov.allows(v1, a) == TRUE_lit);
+
+    bool prop = core->propagate();
+    assert(prop);
+
+    // pruning a value shrinks the domain view..
+    bool assm = core->assume(!ov.allows(v0, b));
+    assert(assm);
+    assert(ov.domain_size(v0) == 2);
+    assert(!ov.contains(v0, b));
+    size_t n_vals = 0;
+    for (const auto &val : ov.domain(v0))
+    {
+        assert(val == &a || val == &c);
+        ++n_vals;
+    }
+    assert(n_vals == 2);
+    assert(ov.value(v0).size() == 2);
+
+    core->pop();
+    assert(ov.domain_size(v0) == 3);
+}
+
+void test_ov_eq_propagation()
+{
+    auto core = sat_ptr(new sat_core());
+    ov_theory ov(core);
+
+    test_val a;
+    test_val b;
+    test_val c;
+
+    var x = ov.new_var({&a, &b, &c});
+    var y = ov.new_var({&a, &b, &c});
+    var z = ov.new_var({&b, &c});
+
+    lit x_eq_y = ov.new_eq(x, y);
+    lit y_eq_z = ov.new_eq(y, z);
+
+    bool prop = core->propagate();
+    assert(prop);
+
+    // the equalities are propagated by the theory, in both directions..
+    bool assm = core->assume(x_eq_y);
+    assert(assm);
+    assm = core->assume(y_eq_z);
+    assert(assm);
+    assert(core->value(ov.allows(x, a)) == utils::False);
+    assm = core->assume(ov.allows(z, c));
+    assert(assm);
+    assert(core->value(ov.allows(x, c)) == utils::True);
+    assert(core->value(ov.allows(y, c)) == utils::True);
+    assert(core->value(ov.allows(x, b)) == utils::False);
+    assert(ov.domain_size(x) == 1);
+    core->pop();
+    core->pop();
+    core->pop();
+
+    // equal values entail the equality..
+    assm = core->assume(ov.allows(x, b));
+    assert(assm);
+    assert(core->value(x_eq_y) == utils::Undefined);
+    assm = core->assume(ov.allows(y, b));
+    assert(assm);
+    assert(core->value(x_eq_y) == utils::True);
+    core->pop();
+    core->pop();
+
+    // a value outside the domain of the other variable contradicts the equality..
+    assm = core->assume(ov.allows(y, a));
+    assert(assm);
+    assert(core->value(y_eq_z) == utils::False);
+    assert(core->value(x_eq_y) == utils::Undefined);
+    assm = core->assume(x_eq_y);
+    assert(assm);
+    assert(core->value(ov.allows(x, a)) == utils::True);
+    assert(core->value(ov.allows(x, b)) == utils::False);
+}
+
+void test_ov_all_different()
+{
+    auto core = sat_ptr(new sat_core());
+    ov_theory ov(core);
+
+    test_val a;
+    test_val b;
+    test_val c;
+
+    var x = ov.new_var({&a, &b});
+    var y = ov.new_var({&a, &b});
+    var z = ov.new_var({&a, &b, &c});
+    var w = ov.new_var({&a, &b});
+
+    bool prop = core->propagate();
+    assert(prop);
+
+    // `x` and `y` take both `a` and `b`, hence `z` must take `c`..
+    bool ad = ov.new_all_different({x, y, z});
+    assert(ad);
+    assert(core->value(ov.allows(z, a)) == utils::False);
+    assert(core->value(ov.allows(z, b)) == utils::False);
+    assert(core->value(ov.allows(z, c)) == utils::True);
+
+    // three variables cannot take two values..
+    ad = ov.new_all_different({x, y, w});
+    assert(!ad);
+}
+
+void test_ov_all_different_incremental()
+{
+    auto core = sat_ptr(new sat_core());
+    ov_theory ov(core);
+
+    test_val a;
+    test_val b;
+    test_val c;
+    test_val d;
+
+    var x = ov.new_var({&a, &b, &c});
+    var y = ov.new_var({&a, &b, &c});
+    var z = ov.new_var({&a, &b, &c, &d});
+
+    bool prop = core->propagate();
+    assert(prop);
+
+    bool ad = ov.new_all_different({x, y, z});
+    assert(ad);
+    assert(core->value(ov.allows(z, d)) == utils::Undefined);
+
+    // once `x` and `y` are restricted to `a` and `b`, these values are removed from `z`..
+    bool assm = core->assume(!ov.allows(x, c));
+    assert(assm);
+    assert(core->value(ov.allows(z, a)) == utils::Undefined);
+    assm = core->assume(!ov.allows(y, c));
+    assert(assm);
+    assert(core->value(ov.allows(z, a)) == utils::False);
+    assert(core->value(ov.allows(z, b)) == utils::False);
+    assert(core->value(ov.allows(z, c)) == utils::Undefined);
+
+    // assigning `b` to `x` assigns `a` to `y`..
+    assm = core->assume(ov.allows(x, b));
+    assert(assm);
+    assert(core->value(ov.allows(y, a)) == utils::True);
+    core->pop();
+    core->pop();
+    core->pop();
+    assert(core->value(ov.allows(z, a)) == utils::Undefined);
+
+    // restricting `z` to `a` and `b` too makes the constraint conflicting, the conflict being explained by the removed values..
+    assm = core->assume(!ov.allows(z, d));
+    assert(assm);
+    assm = core->assume(!ov.allows(x, c));
+    assert(assm);
+    assm = core->assume(!ov.allows(y, c));
+    assert(assm);
+    assert(core->value(ov.allows(z, c)) == utils::True);
+    assm = core->assume(!ov.allows(z, c));
+    assert(!assm);
+}
+
+class delta_listener : public ov_value_listener
+{
+public:
+    delta_listener(ov_theory &th, const var &v) : ov_value_listener(th) { listen_set(v); }
+
+    size_t n_changes = 0;
+    std::vector<utils::enum_val *> removed, restored;
+    utils::enum_val *fixed = nullptr;
+
+private:
+    void ov_domain_change(const var &, const ov_delta &delta) override
+    {
+        ++n_changes;
+        removed = delta.removed;
+        restored = delta.restored;
+        fixed = delta.fixed;
+    }
+};
+
+void test_ov_domain_delta()
+{
+    auto core = sat_ptr(new sat_core());
+    ov_theory ov(core);
+
+    test_val a;
+    test_val b;
+    test_val c;
+
+    var x = ov.new_var({&a, &b, &c});
+    var y = ov.new_var({&a, &b, &c});
+    lit x_eq_y = ov.new_eq(x, y);
+
+    bool prop = core->propagate();
+    assert(prop);
+
+    delta_listener l(ov, x);
+
+    // a single notification carries all the values removed within a propagation round..
+    bool assm = core->assume(x_eq_y);
+    assert(assm);
+    assert(l.n_changes == 0);
+    assm = core->assume(ov.allows(y, b));
+    assert(assm);
+    assert(l.n_changes == 1);
+    assert(l.removed.size() == 2);
+    assert(l.fixed == &b);
+    assert(l.restored.empty());
+
+    // backtracking restores the removed values..
+    core->pop();
+    assert(l.n_changes == 2);
+    assert(l.restored.size() == 2);
+    assert(l.removed.empty() && l.fixed == nullptr);
+
+    // removing a value without fixing the variable..
+    assm = core->assume(!ov.allows(y, c));
+    assert(assm);
+    assert(l.n_changes == 3);
+    assert(l.removed.size() == 1 && l.removed[0] == &c);
+    assert(l.fixed == nullptr);
+}
+
+void test_ov_domain_delta_backjump()
+{
+    auto core = sat_ptr(new sat_core());
+    ov_theory ov(core);
+
+    test_val a;
+    test_val b;
+    test_val c;
+
+    var x = ov.new_var({&a, &b, &c});
+    const lit p(core->new_var()), q(core->new_var());
+    bool nc = core->new_clause({!p, q});
+    assert(nc);
+    nc = core->new_clause({!p, !q});
+    assert(nc);
+
+    bool prop = core->propagate();
+    assert(prop);
+
+    delta_listener l(ov, x);
+
+    bool assm = core->assume(!ov.allows(x, a));
+    assert(assm);
+    assm = core->assume(!ov.allows(x, b));
+    assert(assm);
+    assert(l.n_changes == 2);
+
+    // the conflict backjumps to the root level, and the values restored by the popped levels are delivered at once..
+    assm = core->assume(p);
+    assert(core->root_level());
+    assert(core->value(p) == utils::False);
+    assert(l.n_changes == 3);
+    assert(l.restored.size() == 2);
+    assert(l.removed.empty());
+}
+
 int main(int, char **)
 {
     test_ov_0();
     test_ov_1();
     test_ov_2();
+    test_ov_eq_within_search();
+
+    test_ov_domain();
+    test_ov_eq_propagation();
+
+    test_ov_all_different();
+    test_ov_all_different_incremental();
+
+    test_ov_domain_delta();
+    test_ov_domain_delta_backjump();
 }
\ No newline at end of file
@@ -1,5 +1,7 @@
 #include "sat_core.h"
 #include "sat_stack.h"
+#include "sat_value_listener.h"
+#include <algorithm>
 #include <cassert>
 
 using namespace semitone;
@@ -137,6 +139,85 @@ void test_no_good()
     assert(assm);
 }
 
+class counting_listener : public sat_value_listener
+{
+public:
+    counting_listener(sat_ptr s, const std::vector<var> &vars, const bool batched) : sat_value_listener(s, batched)
+    {
+        for (const auto &v : vars)
+            listen_sat(v);
+    }
+
+    size_t n_calls = 0;
+    std::vector<var> changed;
+
+private:
+    void sat_value_change(const var &v) override
+    {
+        ++n_calls;
+        changed.push_back(v);
+    }
+    void sat_values_change(const std::vector<var> &vars) override
+    {
+        ++n_calls;
+        changed = vars;
+    }
+};
+
+void test_batched_listener()
+{
+    auto core = sat_ptr(new sat_core());
+
+    var b0 = core->new_var();
+    var b1 = core->new_var();
+    var b2 = core->new_var();
+    var b3 = core->new_var();
+    var b4 = core->new_var();
+    var b5 = core->new_var();
+    var b6 = core->new_var();
+    var b7 = core->new_var();
+    var b8 = core->new_var();
+
+    bool nc = core->new_clause({lit(b0), lit(b1)});
+    assert(nc);
+    nc = core->new_clause({lit(b0), lit(b2), lit(b6)});
+    assert(nc);
+    nc = core->new_clause({lit(b1, false), lit(b2, false), lit(b3)});
+    assert(nc);
+    nc = core->new_clause({lit(b3, false), lit(b4), lit(b7)});
+    assert(nc);
+    nc = core->new_clause({lit(b3, false), lit(b5), lit(b8)});
+    assert(nc);
+    nc = core->new_clause({lit(b4, false), lit(b5, false)});
+    assert(nc);
+
+    bool prop = core->propagate();
+    assert(prop);
+
+    counting_listener eager(core, {b1, b2, b3, b4, b5}, false);
+    counting_listener batched(core, {b1, b2, b3, b4, b5}, true);
+
+    bool assm = core->assume(lit(b6, false));
+    assert(assm);
+    assm = core->assume(lit(b7, false));
+    assert(assm);
+    assm = core->assume(lit(b8, false));
+    assert(assm);
+    assert(batched.n_calls == 0);
+
+    // the conflict assigns and unassigns several variables, but only `b3` ends up changed..
+    assm = core->assume(lit(b0, false));
+    assert(assm);
+    assert(core->value(b3) == utils::False);
+    assert(eager.n_calls > 2);
+    assert(batched.n_calls == 1);
+    assert(batched.changed.size() == 1 && batched.changed[0] == b3);
+
+    core->pop();
+    assert(batched.n_calls == 2);
+    assert(batched.changed.size() == 1 && batched.changed[0] == b3);
+}
+
 void test_assumptions()
 {
     sat_core core;
@@ -247,6 +328,634 @@ void test_exct_one_2()
     assert(core.value(b3) == utils::True);
 }
 
+void test_simplify_db()
+{
+    sat_core core;
+
+    var b0 = core.new_var();
+    std::vector<var> bs;
+    for (size_t i = 0; i < 100; ++i)
+        bs.push_back(core.new_var());
+
+    // many clauses which become satisfied once `b0` is asserted..
+    for (size_t i = 0; i + 1 < bs.size(); ++i)
+    {
+        bool nc = core.new_clause({lit(b0), lit(bs[i]), lit(bs[i + 1])});
+        assert(nc);
+    }
+    // ..and a chain of implications which survives the simplification..
+    for (size_t i = 0; i + 1 < bs.size(); ++i)
+    {
+        bool nc = core.new_clause({!lit(bs[i]), lit(bs[i + 1])});
+        assert(nc);
+    }
+
+    bool nc = core.new_clause({lit(b0)});
+    assert(nc);
+    bool simplify = core.simplify_db();
+    assert(simplify);
+    assert(core.value(b0) == utils::True);
+
+    // the surviving clauses still propagate..
+    bool assm = core.assume(lit(bs[0]));
+    assert(assm);
+    assert(core.value(bs.back()) == utils::True);
+    core.pop();
+    assert(core.value(bs.back()) == utils::Undefined);
+
+    assm = core.assume(!lit(bs.back()));
+    assert(assm);
+    assert(core.value(bs[0]) == utils::False);
+    core.pop();
+
+    // a copy of the simplified core is still consistent..
+    sat_core copy(core);
+    assm = copy.assume(lit(bs[50]));
+    assert(assm);
+    assert(copy.value(bs.back()) == utils::True);
+    assert(copy.value(bs[49]) == utils::Undefined);
+}
+
+void test_subsumption()
+{
+    sat_core core;
+
+    var a = core.new_var();
+    var b = core.new_var();
+    var c = core.new_var();
+    var d = core.new_var();
+    var e = core.new_var();
+
+    bool nc = core.new_clause({lit(a), lit(b)});
+    assert(nc);
+    nc = core.new_clause({lit(a), lit(b), lit(c)}); // subsumed by (a | b)..
+    assert(nc);
+    nc = core.new_clause({!lit(a), lit(b), lit(d)}); // strengthened into (b | d)..
+    assert(nc);
+    nc = core.new_clause({lit(c), lit(e)});
+    assert(nc);
+    nc = core.new_clause({lit(c), !lit(e)}); // strengthens (c | e) into the unit (c)..
+    assert(nc);
+
+    bool prop = core.propagate();
+    assert(prop);
+    assert(core.value(c) == utils::Undefined);
+
+    bool sub = core.subsume();
+    assert(sub);
+    assert(core.value(c) == utils::True);
+
+    // the simplified formula is equivalent to the original one..
+    bool assm = core.assume(!lit(b));
+    assert(assm);
+    assert(core.value(a) == utils::True);
+    assert(core.value(d) == utils::True);
+    core.pop();
+
+    assm = core.assume(!lit(d));
+    assert(assm);
+    assert(core.value(b) == utils::True);
+    assert(core.value(a) == utils::Undefined);
+}
+
+void test_elimination()
+{
+    sat_core core;
+
+    var a = core.new_var();
+    var b = core.new_var();
+    var c = core.new_var();
+    var x = core.new_var();
+    var y = core.new_var();
+    // the variables which are going to be assumed must not be eliminated..
+    core.freeze(a);
+    core.freeze(b);
+    core.freeze(c);
+    core.freeze(y);
+
+    bool nc = core.new_clause({!lit(a), lit(x)});
+    assert(nc);
+    nc = core.new_clause({!lit(b), lit(x)});
+    assert(nc);
+    nc = core.new_clause({!lit(x), lit(c)}); // `x` can be replaced by (!a | c) and (!b | c)..
+    assert(nc);
+    nc = core.new_clause({!lit(a), lit(y)});
+    assert(nc);
+    nc = core.new_clause({!lit(y), lit(c)}); // `y` would be eliminable as well, yet it is frozen..
+    assert(nc);
+
+    bool prop = core.propagate();
+    assert(prop);
+
+    bool elim = core.eliminate();
+    assert(elim);
+    assert(core.is_eliminated(x));
+    assert(!core.is_eliminated(y));
+
+    // the simplified formula is equisatisfiable with the original one..
+    bool assm = core.assume(lit(a));
+    assert(assm);
+    assert(core.value(y) == utils::True);
+    assert(core.value(c) == utils::True);
+    assm = core.assume(!lit(b));
+    assert(assm);
+
+    // the model is extended to the eliminated variables..
+    auto model = core.get_model();
+    assert(model[x] == utils::True);
+    core.pop();
+    core.pop();
+
+    assm = core.assume(!lit(c));
+    assert(assm);
+    assert(core.value(a) == utils::False);
+    assert(core.value(b) == utils::False);
+    model = core.get_model();
+    assert(model[x] == utils::False);
+}
+
+void test_substitution()
+{
+    sat_core core;
+
+    var a = core.new_var();
+    var b = core.new_var();
+    var c = core.new_var();
+    var d = core.new_var();
+    core.freeze(a);
+    core.freeze(d);
+
+    // `a`, `b` and `c` are equivalent..
+    bool nc = core.new_clause({!lit(a), lit(b)});
+    assert(nc);
+    nc = core.new_clause({!lit(b), lit(c)});
+    assert(nc);
+    nc = core.new_clause({!lit(c), lit(a)});
+    assert(nc);
+    nc = core.new_clause({lit(b), lit(d)}); // becomes (a | d)..
+    assert(nc);
+
+    bool prop = core.propagate();
+    assert(prop);
+
+    bool subst = core.substitute();
+    assert(subst);
+    assert(!core.is_eliminated(a));
+    assert(core.is_eliminated(b));
+    assert(core.is_eliminated(c));
+    assert(core.representative(!lit(c)) == !lit(a));
+
+    bool assm = core.assume(!lit(a));
+    assert(assm);
+    assert(core.value(b) == utils::False);
+    assert(core.value(c) == utils::False);
+    assert(core.value(d) == utils::True);
+    core.pop();
+    assert(core.value(b) == utils::Undefined);
+
+    // the clauses created after the substitution refer to the representatives..
+    var y = core.new_var();
+    nc = core.new_clause({lit(b), lit(y)}); // becomes (a | y)..
+    assert(nc);
+    assm = core.assume(!lit(a));
+    assert(assm);
+    assert(core.value(y) == utils::True);
+    core.pop();
+    assm = core.assume(!lit(y));
+    assert(assm);
+    assert(core.value(b) == utils::True);
+    core.pop();
+    assert(core.value(y) == utils::Undefined);
+    assert(core.new_conj({lit(c), !lit(a)}) == FALSE_lit);
+
+    // the substituted literals are assumed, checked and looked ahead through their representatives..
+    assm = core.assume(lit(b));
+    assert(assm);
+    assert(core.value(a) == utils::True);
+    assert(core.get_decisions().back() == lit(a));
+    core.pop();
+    std::vector<lit> unsat_core;
+    bool chk = core.check({lit(b), !lit(y), !lit(c)}, unsat_core);
+    assert(!chk);
+    assert(unsat_core.size() == 2);
+    assert(std::find(unsat_core.cbegin(), unsat_core.cend(), lit(b)) != unsat_core.cend());
+    assert(std::find(unsat_core.cbegin(), unsat_core.cend(), !lit(c)) != unsat_core.cend());
+    assert(core.root_level());
+    std::vector<lit> implied;
+    bool la = core.lookahead(!lit(c), implied);
+    assert(la);
+    assert(std::find(implied.cbegin(), implied.cend(), lit(y)) != implied.cend());
+
+    // a literal equivalent to its negation makes the formula unsatisfiable..
+    nc = core.new_clause({lit(a), lit(d)});
+    assert(nc);
+    nc = core.new_clause({!lit(a), !lit(d)});
+    assert(nc);
+    nc = core.new_clause({lit(a), !lit(d)});
+    assert(nc);
+    nc = core.new_clause({!lit(a), lit(d)});
+    assert(nc);
+    prop = core.propagate();
+    assert(prop);
+    subst = core.substitute();
+    assert(!subst);
+}
+
+void test_probing()
+{
+    sat_core core;
+
+    var a = core.new_var();
+    var b = core.new_var();
+    var c = core.new_var();
+    var d = core.new_var();
+    var e = core.new_var();
+    var f = core.new_var();
+    var g = core.new_var();
+
+    bool nc = core.new_clause({!lit(a), lit(b)});
+    assert(nc);
+    nc = core.new_clause({lit(a), lit(b)}); // `b` is implied by both the polarities of `a`..
+    assert(nc);
+    nc = core.new_clause({!lit(c), lit(d)});
+    assert(nc);
+    nc = core.new_clause({!lit(c), !lit(d)}); // `c` is a failed literal..
+    assert(nc);
+    nc = core.new_clause({!lit(e), lit(f)});
+    assert(nc);
+
+    bool prop = core.propagate();
+    assert(prop);
+    assert(core.value(b) == utils::Undefined);
+    assert(core.value(c) == utils::Undefined);
+
+    bool prb = core.probe({lit(a), lit(c), lit(e)});
+    assert(prb);
+    assert(core.value(b) == utils::True);
+    assert(core.value(c) == utils::False);
+    assert(core.value(e) == utils::Undefined);
+
+    std::vector<lit> implied;
+    bool la = core.lookahead(lit(e), implied);
+    assert(la);
+    assert(implied.size() == 2 && implied[0] == lit(e) && implied[1] == lit(f));
+    la = core.lookahead(lit(c), implied);
+    assert(!la);
+
+    // the new clause invalidates the cached lookaheads..
+    nc = core.new_clause({!lit(f), lit(g)});
+    assert(nc);
+    prop = core.propagate();
+    assert(prop);
+    la = core.lookahead(lit(e), implied);
+    assert(la);
+    assert(implied.size() == 3 && implied[2] == lit(g));
+}
+
+void test_unsat_core()
+{
+    sat_core core;
+
+    var a = core.new_var();
+    var b = core.new_var();
+    var c = core.new_var();
+    var d = core.new_var();
+    var e = core.new_var();
+
+    bool nc = core.new_clause({!lit(a), !lit(b), lit(c)});
+    assert(nc);
+    nc = core.new_clause({!lit(c), !lit(d)});
+    assert(nc);
+
+    bool prop = core.propagate();
+    assert(prop);
+
+    std::vector<lit> unsat_core;
+    bool ch = core.check({lit(e), lit(a), lit(b)}, unsat_core);
+    assert(ch);
+    assert(unsat_core.empty());
+
+    // `d` is false because of `a` and `b`, whereas `e` is irrelevant..
+    ch = core.check({lit(e), lit(a), lit(b), lit(d)}, unsat_core);
+    assert(!ch);
+    assert(core.root_level());
+    assert(unsat_core.size() == 3);
+    assert(std::find(unsat_core.cbegin(), unsat_core.cend(), lit(e)) == unsat_core.cend());
+    assert(std::find(unsat_core.cbegin(), unsat_core.cend(), lit(d)) != unsat_core.cend());
+
+    // the minimization removes `b`, since `a` and `!c` suffice..
+    nc = core.new_clause({!lit(a), lit(c)});
+    assert(nc);
+    prop = core.propagate();
+    assert(prop);
+    ch = core.check({lit(b), lit(a), !lit(c)}, unsat_core, 10);
+    assert(!ch);
+    assert(unsat_core.size() == 2);
+    assert(std::find(unsat_core.cbegin(), unsat_core.cend(), lit(b)) == unsat_core.cend());
+}
+
+void test_backbone()
+{
+    sat_core core;
+
+    var a = core.new_var();
+    var b = core.new_var();
+    var c = core.new_var();
+    var d = core.new_var();
+    var e = core.new_var();
+
+    // `a` and `e` are true in every model..
+    bool nc = core.new_clause({lit(a), lit(b)});
+    assert(nc);
+    nc = core.new_clause({lit(a), !lit(b)});
+    assert(nc);
+    nc = core.new_clause({lit(c), lit(d)});
+    assert(nc);
+    nc = core.new_clause({lit(e), lit(b)});
+    assert(nc);
+    nc = core.new_clause({lit(e), !lit(b)});
+    assert(nc);
+
+    bool prop = core.propagate();
+    assert(prop);
+    assert(core.value(a) == utils::Undefined);
+    assert(core.value(e) == utils::Undefined);
+
+    std::vector<lit> bb;
+    bool bbn = core.backbone({lit(a), lit(c), !lit(c), lit(d), lit(e)}, bb);
+    assert(bbn);
+    assert(core.root_level());
+    assert(bb.size() == 2);
+    assert(std::find(bb.cbegin(), bb.cend(), lit(a)) != bb.cend());
+    assert(std::find(bb.cbegin(), bb.cend(), lit(e)) != bb.cend());
+    assert(core.value(a) == utils::True);
+    assert(core.value(e) == utils::True);
+    assert(core.value(c) == utils::Undefined);
+
+    // the candidates are checked one at a time..
+    bbn = core.backbone({lit(c), lit(d), lit(a)}, bb, 1);
+    assert(bbn);
+    assert(bb.size() == 1 && bb[0] == lit(a));
+}
+
+void test_enumerate()
+{
+    sat_core core;
+
+    var a = core.new_var();
+    var b = core.new_var();
+    var c = core.new_var();
+    var y = core.new_var();
+    var z = core.new_var();
+
+    bool nc = core.new_clause({lit(a), lit(b)});
+    assert(nc);
+    nc = core.new_clause({!lit(a), lit(c)}); // `c` is implied by `a`..
+    assert(nc);
+    nc = core.new_clause({!lit(y), lit(z)}); // `y` and `z` are auxiliary variables..
+    assert(nc);
+
+    bool prop = core.propagate();
+    assert(prop);
+
+    // the models differing only in the auxiliary variables are enumerated once..
+    std::vector<std::vector<lit>> models;
+    size_t n_models = core.enumerate({a, b, c}, [&models](const std::vector<lit> &m)
+                                     { models.push_back(m);
+                                       return true; });
+    assert(n_models == 4);
+    assert(models.size() == 4);
+    for (const auto &m : models)
+    {
+        assert(m.size() == 3 && variable(m[0]) == a && variable(m[1]) == b && variable(m[2]) == c);
+        assert(sign(m[0]) || sign(m[1]));
+        assert(!sign(m[0]) || sign(m[2]));
+        assert(std::count(models.cbegin(), models.cend(), m) == 1);
+    }
+
+    // the formula is left unchanged, while the enumeration can be limited..
+    assert(core.root_level());
+    assert(core.value(a) == utils::Undefined);
+    n_models = core.enumerate({a, b}, [](const std::vector<lit> &)
+                              { return true; },
+                              2);
+    assert(n_models == 2);
+    n_models = core.enumerate({a, b}, [](const std::vector<lit> &)
+                              { return true; });
+    assert(n_models == 3);
+}
+
+void test_chrono_backtracking()
+{
+    sat_core core;
+    core.set_chrono_threshold(1);
+
+    var d0 = core.new_var();
+    var d1 = core.new_var();
+    var d2 = core.new_var();
+    var d3 = core.new_var();
+    var x = core.new_var();
+    var y = core.new_var();
+
+    // `x` is inconsistent with `d0`..
+    bool nc = core.new_clause({!lit(d0), !lit(x), lit(y)});
+    assert(nc);
+    nc = core.new_clause({!lit(d0), !lit(x), !lit(y)});
+    assert(nc);
+
+    bool prop = core.propagate();
+    assert(prop);
+
+    bool assm = core.assume(lit(d0));
+    assert(assm);
+    assm = core.assume(lit(d1));
+    assert(assm);
+    assm = core.assume(lit(d2));
+    assert(assm);
+    assm = core.assume(lit(d3));
+    assert(assm);
+
+    // the backjump to the first decision level is replaced by the retraction of the last one..
+    assm = core.assume(lit(x));
+    assert(assm);
+    assert(core.decision_level() == 4);
+    assert(core.value(x) == utils::False);
+    assert(core.value(d3) == utils::True);
+
+    // popping below the level of the asserting literal, but not below the one at which the learnt clause implies it, derives it again..
+    core.pop();
+    assert(core.value(x) == utils::False);
+    core.pop();
+    core.pop();
+    assert(core.decision_level() == 1);
+    assert(core.value(x) == utils::False);
+    assert(core.value(y) == utils::Undefined);
+    core.pop();
+    assert(core.value(x) == utils::Undefined);
+    // the learnt clause still prevents `x`..
+    assm = core.assume(lit(d0));
+    assert(assm);
+    assert(core.value(x) == utils::False);
+
+    // without chronological backtracking, the backjump retracts all the intermediate decision levels..
+    core.pop();
+    core.set_chrono_threshold(std::numeric_limits<size_t>::max());
+    var z = core.new_var();
+    nc = core.new_clause({!lit(d1), !lit(y), lit(z)});
+    assert(nc);
+    nc = core.new_clause({!lit(d1), !lit(y), !lit(z)});
+    assert(nc);
+    prop = core.propagate();
+    assert(prop);
+
+    assm = core.assume(lit(d1));
+    assert(assm);
+    assm = core.assume(lit(d2));
+    assert(assm);
+    assm = core.assume(lit(d3));
+    assert(assm);
+    assm = core.assume(lit(y));
+    assert(assm);
+    assert(core.decision_level() == 1);
+    assert(core.value(y) == utils::False);
+}
+
+void test_budget()
+{
+    sat_core core;
+
+    var a = core.new_var();
+    var b = core.new_var();
+    var c = core.new_var();
+    var d = core.new_var();
+
+    // a -> b -> c -> d
+    bool nc = core.new_clause({!lit(a), lit(b)});
+    assert(nc);
+    nc = core.new_clause({!lit(b), lit(c)});
+    assert(nc);
+    nc = core.new_clause({!lit(c), lit(d)});
+    assert(nc);
+
+    bool prop = core.propagate();
+    assert(prop);
+
+    // the propagation of the chain is interrupted after two literals..
+    sat_budget budget;
+    budget.propagations = 2;
+    core.set_budget(budget);
+    bool assm = core.assume(lit(a));
+    assert(!assm);
+    assert(core.is_interrupted());
+    assert(core.decision_level() == 1);
+    assert(core.value(c) == utils::True);
+    assert(core.value(d) == utils::Undefined);
+
+    // a new budget resumes the propagation..
+    core.set_budget({});
+    prop = core.propagate();
+    assert(prop);
+    assert(!core.is_interrupted());
+    assert(core.value(d) == utils::True);
+    core.pop();
+
+    // an interrupted decision level can be retracted..
+    std::atomic<bool> stop = true;
+    budget = {};
+    budget.interrupt = &stop;
+    core.set_budget(budget);
+    assm = core.assume(lit(a));
+    assert(!assm);
+    assert(core.is_interrupted());
+    core.pop();
+    assert(core.root_level());
+    assert(core.value(a) == utils::Undefined);
+    assert(core.value(b) == utils::Undefined);
+
+    stop = false;
+    assm = core.assume(lit(a));
+    assert(assm);
+    assert(core.value(d) == utils::True);
+    core.pop();
+
+    // the copies of the sat core are subject to the same budget..
+    sat_core i_copy(core);
+    stop = true;
+    assm = i_copy.assume(lit(a));
+    assert(!assm);
+    assert(i_copy.is_interrupted());
+    i_copy.pop();
+    stop = false;
+    budget = {};
+    budget.conflicts = 0;
+    core.set_budget(budget);
+    sat_core c_copy(core);
+    assm = c_copy.assume(lit(a));
+    assert(!assm);
+    assert(c_copy.is_interrupted());
+    c_copy.pop();
+    budget.conflicts = std::numeric_limits<size_t>::max();
+    budget.interrupt = &stop;
+    core.set_budget(budget);
+
+    // the procedures built on top of the propagation return to their initial decision level..
+    stop = true;
+    std::vector<lit> bb;
+    bool bbn = core.backbone({lit(a), lit(b)}, bb);
+    assert(!bbn);
+    assert(core.is_interrupted());
+    assert(core.root_level());
+
+    // the backbone search interrupted while checking a chunk disables, and propagates, the chunk's activation literal..
+    stop = false;
+    budget = {};
+    budget.propagations = 4;
+    core.set_budget(budget);
+    bbn = core.backbone({!lit(a), !lit(b)}, bb);
+    assert(!bbn);
+    assert(core.is_interrupted());
+    assert(core.root_level());
+    assert(core.value(static_cast<var>(d + 1)) == utils::False); // the activation literal..
+    core.set_budget({});
+    assm = core.assume(lit(a));
+    assert(assm);
+    assert(core.value(d) == utils::True);
+    core.pop();
+}
+
+void test_statistics()
+{
+    sat_core core;
+
+    var a = core.new_var();
+    var x = core.new_var();
+    var y = core.new_var();
+
+    // `x` is inconsistent with `a`..
+    bool nc = core.new_clause({!lit(a), !lit(x), lit(y)});
+    assert(nc);
+    nc = core.new_clause({!lit(a), !lit(x), !lit(y)});
+    assert(nc);
+
+    bool assm = core.assume(lit(a));
+    assert(assm);
+    assm = core.assume(lit(x));
+    assert(assm);
+    assert(core.value(x) == utils::False);
+
+#ifndef NO_STATISTICS
+    const auto &stats = core.get_stats();
+    assert(stats.decisions == 2);
+    assert(stats.conflicts == 1);
+    assert(stats.learnts == 1);
+    assert(stats.learnt_lits == 2);
+    assert(stats.propagations == 3); // `a`, `x` and, after the backjump, `!x`..
+    assert(stats.watch_visits > 0);
+#endif
+
+    [[maybe_unused]] auto j_sat = to_json(core);
+}
+
 void test_sat_stack_0()
 {
     LOG("test_sat_stack_0");
@@ -324,12 +1033,26 @@ int main(int, char **)
 
     test_no_good();
 
+    test_batched_listener();
+
     test_assumptions();
 
     test_exct_one_0();
     test_exct_one_1();
     test_exct_one_2();
 
+    test_simplify_db();
+    test_subsumption();
+    test_elimination();
+    test_substitution();
+    test_probing();
+    test_unsat_core();
+    test_backbone();
+    test_enumerate();
+    test_chrono_backtracking();
+    test_budget();
+    test_statistics();
+
     test_sat_stack_0();
 
     test_to_json();